@@ -0,0 +1,43 @@
+#include <BatchHull.h>
+
+#include <Parallel.h>
+#include <ScratchHull.h>
+
+#include <cassert>
+#include <cstring>
+
+namespace ch
+{
+    point_groups batch_hulls(std::span<const v2> points, std::span<const int> offsets)
+    {
+        assert(!offsets.empty() && offsets.front() == 0 && offsets.back() == static_cast<int>(points.size()));
+
+        int groups_count{ static_cast<int>(offsets.size()) - 1 };
+        point_groups hulls{};
+        hulls.points.resize(points.size());
+        hulls.offsets.resize(offsets.size());
+
+        // every hull is written where its group starts, as it is never larger than the group
+        std::vector<int> sizes(groups_count);
+        parallel_for(groups_count, [&](int begin, int end)
+        {
+            for (int i{ begin }; i < end; i++)
+            {
+                assert(offsets[i] <= offsets[i + 1]);
+                sizes[i] = scratch_hull(points.data() + offsets[i], offsets[i + 1] - offsets[i], hulls.points.data() + offsets[i]);
+            }
+        });
+
+        // then hulls are packed to the front, in place: a hull never moves past where it is
+        int size{};
+        for (int i{}; i < groups_count; i++)
+        {
+            hulls.offsets[i] = size;
+            std::memmove(hulls.points.data() + size, hulls.points.data() + offsets[i], sizes[i] * sizeof(v2));
+            size += sizes[i];
+        }
+        hulls.offsets[groups_count] = size;
+        hulls.points.resize(size);
+        return hulls;
+    }
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <ConvexHull.h>
+
+#include <span>
+#include <vector>
+
+namespace ch
+{
+    /*
+        Groups of points in a flat buffer (CSR layout): group i is points[offsets[i], offsets[i + 1]).
+        offsets starts with 0 and has one more element than there are groups.
+    */
+    struct point_groups
+    {
+        std::vector<v2> points;
+        std::vector<int> offsets{ 0 };
+
+        int size() const { return static_cast<int>(offsets.size()) - 1; }
+        std::span<const v2> group(int i) const { return { points.data() + offsets[i], points.data() + offsets[i + 1] }; }
+    };
+
+    /*
+        Hulls of many small groups of points (in CSR layout, as above) in a single call, returned in the same layout.
+        Hulls are clockwise from the leftmost point, without collinear points. Groups of one or two points are their own
+        hull (duplicates removed). Groups are spread across threads, and every thread reuses the same scratch memory for
+        all of its groups, so that the only allocations are the output ones.
+    */
+    point_groups batch_hulls(std::span<const v2> points, std::span<const int> offsets);
+}
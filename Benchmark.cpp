@@ -0,0 +1,270 @@
+#include <Benchmark.h>
+
+#include <KillZone.h>
+#include <Parallel.h>
+
+#include <algorithm>
+#include <cassert>
+#include <charconv>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+
+namespace ch
+{
+    static bool fail(std::string* error, const std::string& message)
+    {
+        if (error)
+        {
+            *error = message;
+        }
+        return false;
+    }
+
+    template<typename T>
+    static bool parse_number(const std::string& text, T& value)
+    {
+        auto [end, parse_error] { std::from_chars(text.data(), text.data() + text.size(), value) };
+        return parse_error == std::errc{} && end == text.data() + text.size();
+    }
+
+    static std::vector<std::string> split(const std::string& text, char separator)
+    {
+        std::vector<std::string> parts{};
+        std::size_t begin{};
+        while (true)
+        {
+            std::size_t end{ text.find(separator, begin) };
+            parts.emplace_back(text.substr(begin, end == std::string::npos ? std::string::npos : end - begin));
+            if (end == std::string::npos)
+            {
+                return parts;
+            }
+            begin = end + 1;
+        }
+    }
+
+    // min:max:step or min:max:xgrowth
+    static bool parse_sizes(const std::string& text, benchmark_options& options)
+    {
+        std::vector<std::string> parts{ split(text, ':') };
+        if (parts.size() != 3 || !parse_number(parts[0], options.min_n) || !parse_number(parts[1], options.max_n))
+        {
+            return false;
+        }
+        if (options.min_n < 3 || options.max_n < options.min_n)
+        {
+            return false;
+        }
+        if (!parts[2].empty() && parts[2][0] == 'x')
+        {
+            options.step = 0;
+            return parse_number(parts[2].substr(1), options.growth) && options.growth > 1.0;
+        }
+        options.growth = 0.0;
+        return parse_number(parts[2], options.step) && options.step > 0;
+    }
+
+    bool parse_benchmark_options(int argc, const char* const* argv, benchmark_options& options, std::string* error)
+    {
+        for (int i{}; i < argc; i++)
+        {
+            std::string option{ argv[i] };
+            if (i + 1 >= argc)
+            {
+                return fail(error, "missing value of " + option);
+            }
+            std::string value{ argv[++i] };
+
+            bool ok{ true };
+            if (option == "--algorithms")
+            {
+                options.algorithms = split(value, ',');
+            }
+            else if (option == "--distributions")
+            {
+                options.distributions.clear();
+                for (const std::string& name : split(value, ','))
+                {
+                    distribution d{};
+                    if (!parse_distribution(name, d))
+                    {
+                        return fail(error, "unknown distribution " + name);
+                    }
+                    options.distributions.emplace_back(d);
+                }
+            }
+            else if (option == "--n")
+            {
+                ok = parse_sizes(value, options);
+            }
+            else if (option == "--warmup")
+            {
+                ok = parse_number(value, options.warmup) && options.warmup >= 0;
+            }
+            else if (option == "--repetitions")
+            {
+                ok = parse_number(value, options.repetitions) && options.repetitions >= 1;
+            }
+            else if (option == "--budget")
+            {
+                ok = parse_number(value, options.budget_seconds) && options.budget_seconds > 0.0;
+            }
+            else if (option == "--seed")
+            {
+                ok = parse_number(value, options.seed);
+            }
+            else if (option == "--csv")
+            {
+                options.csv_path = value;
+            }
+            else if (option == "--json")
+            {
+                options.json_path = value;
+            }
+            else
+            {
+                return fail(error, "unknown option " + option);
+            }
+
+            if (!ok)
+            {
+                return fail(error, "malformed value of " + option + ": " + value);
+            }
+        }
+        return true;
+    }
+
+    std::vector<long long> benchmark_sizes(const benchmark_options& options)
+    {
+        assert(options.growth > 1.0 || options.step > 0);
+
+        std::vector<long long> sizes{};
+        if (options.growth > 1.0)
+        {
+            // rounded from the exact geometric sequence (so that e.g. x10 lands on powers of ten), without repeating an n
+            for (int i{}; ; i++)
+            {
+                long long n{ std::llround(static_cast<double>(options.min_n) * std::pow(options.growth, i)) };
+                if (n > options.max_n)
+                {
+                    break;
+                }
+                if (sizes.empty() || n > sizes.back())
+                {
+                    sizes.emplace_back(n);
+                }
+            }
+        }
+        else
+        {
+            for (long long n{ options.min_n }; n <= options.max_n; n += options.step)
+            {
+                sizes.emplace_back(n);
+            }
+        }
+        return sizes;
+    }
+
+    timing_summary summarize_timings(std::vector<double> samples_ns)
+    {
+        assert(!samples_ns.empty());
+
+        std::sort(samples_ns.begin(), samples_ns.end());
+        int count{ static_cast<int>(samples_ns.size()) };
+
+        timing_summary summary{};
+        summary.min_ns = samples_ns.front();
+        summary.median_ns = count % 2 == 1 ? samples_ns[count / 2] : (samples_ns[count / 2 - 1] + samples_ns[count / 2]) / 2.0;
+        summary.p95_ns = samples_ns[static_cast<int>(std::ceil(0.95 * count)) - 1];
+
+        double sum{};
+        for (double sample : samples_ns)
+        {
+            sum += sample;
+        }
+        summary.mean_ns = sum / count;
+
+        if (count > 1)
+        {
+            double squares{};
+            for (double sample : samples_ns)
+            {
+                squares += (sample - summary.mean_ns) * (sample - summary.mean_ns);
+            }
+            summary.stddev_ns = std::sqrt(squares / (count - 1));
+        }
+        return summary;
+    }
+
+    static bool finish(std::ofstream& out, const std::string& path, std::string* error)
+    {
+        out.flush();
+        return out ? true : fail(error, "can't write " + path);
+    }
+
+    bool write_benchmark_csv(const std::string& path, const std::vector<benchmark_record>& records, std::string* error)
+    {
+        std::ofstream out{ path };
+        if (!out)
+        {
+            return fail(error, "can't open " + path);
+        }
+
+        out << std::fixed << std::setprecision(3);
+        out << "algorithm,distribution,n,repetitions,min_ns,median_ns,p95_ns,mean_ns,stddev_ns,ns_per_point,hull_size,allocations,"
+            << "orientations,orientation_fallbacks,kill_zone_discarded,kill_zone_survivors,merge_tangent_steps,convexify_deletions,convexify_restarts\n";
+        for (const benchmark_record& r : records)
+        {
+            out << r.algorithm << ',' << r.distribution << ',' << r.n << ',' << r.repetitions << ','
+                << r.timings.min_ns << ',' << r.timings.median_ns << ',' << r.timings.p95_ns << ',' << r.timings.mean_ns << ',' << r.timings.stddev_ns << ','
+                << r.ns_per_point << ',' << r.hull_size << ',' << r.allocations << ',';
+            // empty cells if the stats are compiled out, rather than zeros that look like counts
+            if (HULL_STATS_ENABLED)
+            {
+                out << r.stats.orientations << ',' << r.stats.orientation_fallbacks << ',' << r.stats.kill_zone_discarded << ',' << r.stats.kill_zone_survivors << ','
+                    << r.stats.merge_tangent_steps << ',' << r.stats.convexify_deletions << ',' << r.stats.convexify_restarts;
+            }
+            else
+            {
+                out << ",,,,,,";
+            }
+            out << '\n';
+        }
+        return finish(out, path, error);
+    }
+
+    bool write_benchmark_json(const std::string& path, const std::vector<benchmark_record>& records, std::string* error)
+    {
+        std::ofstream out{ path };
+        if (!out)
+        {
+            return fail(error, "can't open " + path);
+        }
+
+        // names are identifiers (algorithm and distribution names), so they need no escaping
+        out << std::fixed << std::setprecision(3);
+        out << "{\n\"kill_zone_kernel\": \"" << kill_zone_kernel_name() << "\",\n\"threads\": " << thread_count()
+            << ",\n\"hull_stats\": " << (HULL_STATS_ENABLED ? "true" : "false") << ",\n\"results\": [";
+        for (int i{}; i < static_cast<int>(records.size()); i++)
+        {
+            const benchmark_record& r{ records[i] };
+            out << (i == 0 ? "\n" : ",\n")
+                << "{\"algorithm\": \"" << r.algorithm << "\", \"distribution\": \"" << r.distribution << "\", \"n\": " << r.n
+                << ", \"repetitions\": " << r.repetitions
+                << ", \"min_ns\": " << r.timings.min_ns << ", \"median_ns\": " << r.timings.median_ns << ", \"p95_ns\": " << r.timings.p95_ns
+                << ", \"mean_ns\": " << r.timings.mean_ns << ", \"stddev_ns\": " << r.timings.stddev_ns << ", \"ns_per_point\": " << r.ns_per_point
+                << ", \"hull_size\": " << r.hull_size << ", \"allocations\": " << r.allocations;
+            if (HULL_STATS_ENABLED)
+            {
+                out << ", \"orientations\": " << r.stats.orientations << ", \"orientation_fallbacks\": " << r.stats.orientation_fallbacks
+                    << ", \"kill_zone_discarded\": " << r.stats.kill_zone_discarded << ", \"kill_zone_survivors\": " << r.stats.kill_zone_survivors
+                    << ", \"merge_tangent_steps\": " << r.stats.merge_tangent_steps << ", \"convexify_deletions\": " << r.stats.convexify_deletions
+                    << ", \"convexify_restarts\": " << r.stats.convexify_restarts;
+            }
+            out << "}";
+        }
+        out << "\n]\n}\n";
+        return finish(out, path, error);
+    }
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <Dataset.h>
+#include <HullStats.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ch
+{
+    /*
+        Benchmark harness: which (algorithm, distribution, n) points to measure and how, the summary statistics of the
+        repeated timings and their machine readable output (CSV and JSON, loaded by the website charts).
+        The timing loop itself lives with the algorithms table, in Main.cpp.
+    */
+
+    struct benchmark_options
+    {
+        std::vector<std::string> algorithms{};                // names, empty for all of them
+        std::vector<distribution> distributions{};            // empty for all of them
+        long long min_n{ 100 };
+        long long max_n{ 10000 };
+        long long step{ 100 };                                // linear steps: n, n + step, n + 2 step, ...
+        double growth{};                                      // geometric steps if > 1: n, n * growth, n * growth^2, ...
+        int warmup{ 1 };                                      // untimed runs before the timed ones, at every n
+        int repetitions{ 5 };                                 // timed runs at every n
+        double budget_seconds{ 60.0 * 3.0 };                  // per (algorithm, distribution): larger n are skipped past it
+        std::uint64_t seed{ 1 };                              // always the same datasets, so that different runs can be compared
+        std::string csv_path{ "benchmark.csv" };              // empty for no CSV output
+        std::string json_path{ "benchmark.json" };            // empty for no JSON output
+    };
+
+    /*
+        Parses the benchmark options from the command line (the arguments after "benchmark"):
+            --algorithms a,b,...     --distributions d,e,...   --n min:max:step or min:max:xgrowth (e.g. 100:100000000:x10)
+            --warmup w               --repetitions r           --budget seconds
+            --seed s                 --csv path                --json path
+        Returns false, and sets error, on unknown options or malformed values.
+    */
+    bool parse_benchmark_options(int argc, const char* const* argv, benchmark_options& options, std::string* error = nullptr);
+
+    // the n of the benchmark points, in increasing order
+    std::vector<long long> benchmark_sizes(const benchmark_options& options);
+
+    // summary statistics of the timings of the repetitions at one benchmark point, in nanoseconds
+    struct timing_summary
+    {
+        double min_ns{};
+        double median_ns{};
+        double p95_ns{};    // nearest rank percentile
+        double mean_ns{};
+        double stddev_ns{}; // sample standard deviation, zero for a single repetition
+    };
+
+    timing_summary summarize_timings(std::vector<double> samples_ns);
+
+    struct benchmark_record
+    {
+        std::string algorithm{};
+        std::string distribution{};
+        long long n{};
+        int repetitions{};
+        timing_summary timings{};
+        double ns_per_point{}; // median time over n
+        long long hull_size{};
+        long long allocations{}; // of a single run
+        hull_stats stats{};      // of a single run
+    };
+
+    // one line per record, with a header. returns false (and, if given, sets error) if the file can't be written
+    bool write_benchmark_csv(const std::string& path, const std::vector<benchmark_record>& records, std::string* error = nullptr);
+
+    // { "kill_zone_kernel": ..., "threads": ..., "hull_stats": ..., "results": [ one object per record ] }
+    // the operation counts are left out of both (empty CSV cells, missing JSON fields) if CH_HULL_STATS is 0
+    bool write_benchmark_json(const std::string& path, const std::vector<benchmark_record>& records, std::string* error = nullptr);
+}
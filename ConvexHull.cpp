@@ -1,9 +1,20 @@
 #include <ConvexHull.h>
 
+#include <KillZone.h>
+#include <MonotoneChain.h>
+#include <Parallel.h>
+#include <PointSet.h>
+#include <Predicates.h>
+#include <Trace.h>
+
 #include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <cstring>
+#include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 
 template<>
 struct std::hash<ch::v2>
@@ -18,64 +29,113 @@ struct std::hash<ch::v2>
 
 namespace ch
 {
-    static bool is_hull_clockwise(const std::vector<v2> hull)
+    template<typename T>
+    static bool is_hull_clockwise(const std::vector<basic_v2<T>> hull)
     {
         assert(hull.size() >= 3);
 
-        v2 a{ hull[0] };
-        v2 b{ hull[1] };
-        v2 c{ hull[2] };
+        basic_v2<T> a{ hull[0] };
+        basic_v2<T> b{ hull[1] };
+        basic_v2<T> c{ hull[2] };
+        return orientation(a, b, c) <= 0;
+    }
+
+    // lexicographic order: by x, then by y
+    template<typename T>
+    static bool lexicographic_less(basic_v2<T> a, basic_v2<T> b)
+    {
+        return a.x < b.x || (a.x == b.x && a.y < b.y);
+    }
+
+    template<typename T>
+    static bool x_less(basic_v2<T> a, basic_v2<T> b)
+    {
+        return a.x < b.x;
+    }
+
+    // points are sorted by x: sorts the runs of points sharing the same x by y, so that they end up in lexicographic order
+    template<typename T>
+    static void sort_same_x_by_y(std::vector<basic_v2<T>>& points)
+    {
+        auto run{ points.begin() };
+        while (run != points.end())
+        {
+            auto run_end{ std::find_if(run + 1, points.end(), [=](basic_v2<T> p) { return p.x != run->x; }) };
+            if (run_end - run > 1)
+            {
+                std::sort(run, run_end, [](basic_v2<T> a, basic_v2<T> b) { return a.y < b.y; });
+            }
+            run = run_end;
+        }
+    }
 
-        v2 a_to_b{ b - a };
-        v2 b_to_c{ c - b };
-        return determinant(a_to_b, b_to_c) <= 0;
+    /*
+        Sorts points in lexicographic order. Sorting by x alone takes a single comparison and is noticeably faster, while
+        points sharing the same x are rare: they are sorted by y afterwards, in a linear pass.
+    */
+    template<typename T>
+    static void sort_lexicographic(std::vector<basic_v2<T>>& points)
+    {
+        std::sort(points.begin(), points.end(), x_less<T>);
+        sort_same_x_by_y(points);
     }
 
     std::vector<v2> naive(const std::vector<v2>& points)
     {
         assert(points.size() >= 3);
 
+        // duplicates would give edges of zero length
+        std::vector<v2> distinct{ points };
+        sort_lexicographic(distinct);
+        distinct.erase(std::unique(distinct.begin(), distinct.end()), distinct.end());
+        if (distinct.size() == 1)
+        {
+            return distinct;
+        }
+
         std::unordered_map<v2, std::vector<v2>> graph{};
 
         // find hull edges
-        for (int i{}; i < static_cast<int>(points.size()); i++)
+        for (int i{}; i < static_cast<int>(distinct.size()); i++)
         {
-            for (int j{ i + 1 }; j < static_cast<int>(points.size()); j++)
+            for (int j{ i + 1 }; j < static_cast<int>(distinct.size()); j++)
             {
-                v2 u{ points[i] };
-                v2 v{ points[j] };
-                v2 u_to_v{ v - u };
-                v2 normal{ v2::normal(u_to_v) };
+                v2 u{ distinct[i] };
+                v2 v{ distinct[j] };
 
                 int positive_halfplane{};
                 int negative_halfplane{};
-                for (int k{}; k < static_cast<int>(points.size()); k++)
+                bool collinear_outside{};
+                for (int k{}; k < static_cast<int>(distinct.size()); k++)
                 {
                     if (k == i || k == j) continue;
 
-                    v2 p{ points[k] };
-                    v2 u_to_p{ p - u };
-                    double dot{ v2::dot(normal, u_to_p) };
-                    /*
-                        It is not possible for dot to be zero.
-                        This is because, by precondition, we assume that our set does not contain collinear points.
-                    */
-                    assert(dot != 0);
-                    if (dot > 0)
+                    v2 p{ distinct[k] };
+                    double side{ orientation(u, v, p) };
+                    if (side > 0)
                     {
                         positive_halfplane++;
                     }
-                    else // dot < 0
+                    else if (side < 0)
                     {
                         negative_halfplane++;
                     }
+                    else
+                    {
+                        /*
+                            p lies on the line through u and v. If it lies outside of the segment u -> v, then either u or v
+                            is between two points of the set, thus not a hull vertex. Since u -> v and u -> p are parallel,
+                            the dot product has no cancellation and its sign is exact.
+                        */
+                        collinear_outside = collinear_outside || v2::dot(p - u, v - u) < 0 || v2::dot(p - v, u - v) < 0;
+                    }
                 }
 
                 // update edge list
-                if (positive_halfplane == 0 || negative_halfplane == 0)
+                if ((positive_halfplane == 0 || negative_halfplane == 0) && !collinear_outside)
                 {
-                    graph[points[i]].emplace_back(points[j]);
-                    graph[points[j]].emplace_back(points[i]);
+                    graph[distinct[i]].emplace_back(distinct[j]);
+                    graph[distinct[j]].emplace_back(distinct[i]);
                 }
             }
         }
@@ -93,14 +153,17 @@ namespace ch
                 hull.emplace_back(current_hull_point);
 
                 auto next{ std::find_if(graph[current_hull_point].begin(), graph[current_hull_point].end(), [=](v2 p) { return p != previous_hull_point; }) };
-                assert(next != graph[current_hull_point].end());
+                if (next == graph[current_hull_point].end())
+                {
+                    break; // all the points are collinear: the hull is a single edge
+                }
                 previous_hull_point = current_hull_point;
                 current_hull_point = *next;
             } while (current_hull_point != first_hull_point);
         }
 
         // make hull clockwise
-        if (!is_hull_clockwise(hull))
+        if (hull.size() >= 3 && !is_hull_clockwise(hull))
         {
             std::reverse(hull.begin(), hull.end());
         }
@@ -119,31 +182,31 @@ namespace ch
         return (((i - 1) % isize) + isize) % isize;
     }
 
-    static double get_intersect_y(double middle_x, v2 p, v2 q)
-    {
-        double m{ (p.y - q.y) / (p.x - q.x) };
-        double b{ p.y - m * p.x }; // b = y - mx
-        double intersect_y{ m * middle_x + b }; // y = mx + b
-        return intersect_y;
-    }
-
-    static std::vector<v2> divide_and_conquer_merge(const std::vector<v2>& hull_a, const std::vector<v2>& hull_b)
+    /*
+        Merges the clockwise hulls hull_a[0, size_a) and hull_b[0, size_b), where all the points of hull_a come before the
+        ones of hull_b in lexicographic order (so there is a line separating the two).
+        The clockwise merged hull is written to hull, which must not overlap with the input hulls.
+        Returns the size of the merged hull, which is at most size_a + size_b.
+        Tangents are walked with orientation tests. A point collinear with the current tangent is moved to only if it
+        is farther away from the other hull (i.e. lexicographically before, for a, and after, for b), so that hulls of one
+        or two points, and collinear points, are handled as well.
+    */
+    static int divide_and_conquer_merge(const v2* hull_a, int size_a, const v2* hull_b, int size_b, v2* hull)
     {
-        assert(hull_a.size() > 0);
-        assert(hull_b.size() > 0);
+        assert(size_a > 0);
+        assert(size_b > 0);
 
         // find rightmost point of a and leftmost point of b
         int leftmost_idx{}, rightmost_idx{};
         {
-            auto leftmost_iterator{ std::min_element(hull_b.begin(), hull_b.end(), [](const v2& a, const v2& b) { return a.x < b.x; }) };
-            auto rightmost_iterator{ std::max_element(hull_a.begin(), hull_a.end(), [](const v2& a, const v2& b) { return a.x < b.x; }) };
-            leftmost_idx = static_cast<int>(std::distance(hull_b.begin(), leftmost_iterator));
-            rightmost_idx = static_cast<int>(std::distance(hull_a.begin(), rightmost_iterator));
+            auto leftmost_iterator{ std::min_element(hull_b, hull_b + size_b, lexicographic_less<double>) };
+            auto rightmost_iterator{ std::max_element(hull_a, hull_a + size_a, lexicographic_less<double>) };
+            leftmost_idx = static_cast<int>(std::distance(hull_b, leftmost_iterator));
+            rightmost_idx = static_cast<int>(std::distance(hull_a, rightmost_iterator));
         }
 
-        double middle_line{ (hull_a[rightmost_idx].x + hull_b[leftmost_idx].x) / 2.0 }; // middle vertical line (the x value) separating the two hulls
-
-        // find upper tangent
+        // find upper tangent: no point lies to the left of a -> b
+        int tangent_steps{};
         int upper_tangent_a_idx{}, upper_tangent_b_idx{};
         {
             int i{ rightmost_idx };
@@ -151,16 +214,20 @@ namespace ch
 
             while (true)
             {
-                int next_i{ get_next_idx_ccw(i, hull_a.size()) };
-                int next_j{ get_next_idx_cw(j, hull_b.size()) };
+                int next_i{ get_next_idx_ccw(i, size_a) };
+                int next_j{ get_next_idx_cw(j, size_b) };
 
-                if (get_intersect_y(middle_line, hull_a[next_i], hull_b[j]) > get_intersect_y(middle_line, hull_a[i], hull_b[j]))
+                double side_a{ orientation(hull_a[i], hull_b[j], hull_a[next_i]) };
+                double side_b{ orientation(hull_a[i], hull_b[j], hull_b[next_j]) };
+                if (side_a > 0 || (side_a == 0 && lexicographic_less(hull_a[next_i], hull_a[i])))
                 {
                     i = next_i;
+                    tangent_steps++;
                 }
-                else if (get_intersect_y(middle_line, hull_a[i], hull_b[next_j]) > get_intersect_y(middle_line, hull_a[i], hull_b[j]))
+                else if (side_b > 0 || (side_b == 0 && lexicographic_less(hull_b[j], hull_b[next_j])))
                 {
                     j = next_j;
+                    tangent_steps++;
                 }
                 else
                 {
@@ -172,7 +239,7 @@ namespace ch
             upper_tangent_b_idx = j;
         }
 
-        // find lower tangent
+        // find lower tangent: no point lies to the right of a -> b
         int lower_tangent_a_idx{}, lower_tangent_b_idx{};
         {
             int i{ rightmost_idx };
@@ -180,16 +247,20 @@ namespace ch
 
             while (true)
             {
-                int next_i{ get_next_idx_cw(i, hull_a.size()) };
-                int next_j{ get_next_idx_ccw(j, hull_b.size()) };
+                int next_i{ get_next_idx_cw(i, size_a) };
+                int next_j{ get_next_idx_ccw(j, size_b) };
 
-                if (get_intersect_y(middle_line, hull_a[next_i], hull_b[j]) < get_intersect_y(middle_line, hull_a[i], hull_b[j]))
+                double side_a{ orientation(hull_a[i], hull_b[j], hull_a[next_i]) };
+                double side_b{ orientation(hull_a[i], hull_b[j], hull_b[next_j]) };
+                if (side_a < 0 || (side_a == 0 && lexicographic_less(hull_a[next_i], hull_a[i])))
                 {
                     i = next_i;
+                    tangent_steps++;
                 }
-                else if (get_intersect_y(middle_line, hull_a[i], hull_b[next_j]) < get_intersect_y(middle_line, hull_a[i], hull_b[j]))
+                else if (side_b < 0 || (side_b == 0 && lexicographic_less(hull_b[j], hull_b[next_j])))
                 {
                     j = next_j;
+                    tangent_steps++;
                 }
                 else
                 {
@@ -200,72 +271,350 @@ namespace ch
             lower_tangent_a_idx = i;
             lower_tangent_b_idx = j;
         }
+        count_hull_stat(hull_counter::merge_tangent_steps, tangent_steps);
 
         // clockwise merge the two hulls using the found tangents
-        std::vector<v2> hull{};
-        for (int i{ lower_tangent_a_idx }; i != upper_tangent_a_idx; i = get_next_idx_cw(i, hull_a.size()))
+        int size{};
+        for (int i{ lower_tangent_a_idx }; i != upper_tangent_a_idx; i = get_next_idx_cw(i, size_a))
         {
-            hull.emplace_back(hull_a[i]);
+            hull[size++] = hull_a[i];
         }
-        hull.emplace_back(hull_a[upper_tangent_a_idx]);
-        for (int j{ upper_tangent_b_idx }; j != lower_tangent_b_idx; j = get_next_idx_cw(j, hull_b.size()))
+        hull[size++] = hull_a[upper_tangent_a_idx];
+        for (int j{ upper_tangent_b_idx }; j != lower_tangent_b_idx; j = get_next_idx_cw(j, size_b))
         {
-            hull.emplace_back(hull_b[j]);
+            hull[size++] = hull_b[j];
         }
-        hull.emplace_back(hull_b[lower_tangent_b_idx]);
+        hull[size++] = hull_b[lower_tangent_b_idx];
 
-        return hull;
+        return size;
+    }
+
+    /*
+        Base case of the divide and conquer recursion: clockwise hull of N distinct points sorted in lexicographic order,
+        without any heap memory.
+        Upper and lower chains are built with Andrew's monotone chain on fixed size arrays. N is a compile time constant,
+        so the loops get fully unrolled.
+        hull may coincide with sorted_points, since all the points are read before the first write.
+    */
+    template<int N>
+    static int small_hull(const v2* sorted_points, v2* hull)
+    {
+        if constexpr (N <= 2)
+        {
+            for (int i{}; i < N; i++)
+            {
+                hull[i] = sorted_points[i];
+            }
+            return N;
+        }
+        else
+        {
+            v2 upper[N]{};
+            v2 lower[N]{};
+            int upper_size{};
+            int lower_size{};
+            for (int i{}; i < N; i++)
+            {
+                v2 p{ sorted_points[i] };
+                while (upper_size >= 2 && orientation(upper[upper_size - 2], upper[upper_size - 1], p) >= 0)
+                {
+                    upper_size--; // not a right turn
+                }
+                upper[upper_size++] = p;
+                while (lower_size >= 2 && orientation(lower[lower_size - 2], lower[lower_size - 1], p) <= 0)
+                {
+                    lower_size--; // not a left turn
+                }
+                lower[lower_size++] = p;
+            }
+
+            // clockwise: upper chain from left to right, then lower chain from right to left (without the shared extremes)
+            int size{};
+            for (int i{}; i < upper_size; i++)
+            {
+                hull[size++] = upper[i];
+            }
+            for (int i{ lower_size - 2 }; i > 0; i--)
+            {
+                hull[size++] = lower[i];
+            }
+            return size;
+        }
     }
 
-    static std::vector<v2> divide_and_conquer_impl(const std::vector<v2>& sorted_points)
+    static int small_hull(const v2* sorted_points, int count, v2* hull)
     {
-        if (sorted_points.size() <= 1)
+        static_assert(DIVIDE_AND_CONQUER_MAX_BASE_CASE_SIZE == 8);
+        switch (count)
         {
-            return sorted_points;
+        case 1: return small_hull<1>(sorted_points, hull);
+        case 2: return small_hull<2>(sorted_points, hull);
+        case 3: return small_hull<3>(sorted_points, hull);
+        case 4: return small_hull<4>(sorted_points, hull);
+        case 5: return small_hull<5>(sorted_points, hull);
+        case 6: return small_hull<6>(sorted_points, hull);
+        case 7: return small_hull<7>(sorted_points, hull);
+        case 8: return small_hull<8>(sorted_points, hull);
+        }
+        assert(false);
+        return 0;
+    }
+
+    /*
+        Computes the hull of sorted_points[begin, end) and writes it to out[begin, begin + hull size), returning the hull size.
+        The hulls of the two halves are computed into scratch (using out as their own scratch) and then merged into out.
+        Since every sub-range only ever writes inside of itself, the whole recursion needs no memory other than the two buffers.
+        sorted_points may coincide with out or scratch: a point is always read before its slot gets overwritten.
+    */
+    static int divide_and_conquer_impl(const v2* sorted_points, v2* out, v2* scratch, int begin, int end, int base_case_size)
+    {
+        if (end - begin <= base_case_size)
+        {
+            return small_hull(sorted_points + begin, end - begin, out + begin);
         }
         else
         {
-            int half{ static_cast<int>(sorted_points.size()) / 2 }; // half >= 1
-            std::vector<v2> hull_a{ divide_and_conquer_impl({sorted_points.begin(), sorted_points.begin() + half}) };
-            std::vector<v2> hull_b{ divide_and_conquer_impl({sorted_points.begin() + half, sorted_points.end()}) };
-            return divide_and_conquer_merge(hull_a, hull_b);
+            int middle{ begin + (end - begin) / 2 }; // middle > begin
+            int size_a{ divide_and_conquer_impl(sorted_points, scratch, out, begin, middle, base_case_size) };
+            int size_b{ divide_and_conquer_impl(sorted_points, scratch, out, middle, end, base_case_size) };
+            return divide_and_conquer_merge(scratch + begin, size_a, scratch + middle, size_b, out + begin);
+        }
+    }
+
+    // divide and conquer on a local copy of the points, which gets sorted and then reused as output buffer
+    static std::vector<v2> divide_and_conquer_on_copy(std::vector<v2> copy, int base_case_size)
+    {
+        assert(copy.size() >= 3);
+        assert(1 <= base_case_size && base_case_size <= DIVIDE_AND_CONQUER_MAX_BASE_CASE_SIZE);
+
+        // sort local copy of points. duplicates are dropped, so that the two halves of every split are disjoint
+        {
+            trace_span span{ "sort" };
+            sort_lexicographic(copy);
+            copy.erase(std::unique(copy.begin(), copy.end()), copy.end());
         }
+
+        trace_span span{ "recurse and merge" };
+        std::vector<v2> scratch(copy.size());
+        int size{ divide_and_conquer_impl(copy.data(), copy.data(), scratch.data(), 0, static_cast<int>(copy.size()), base_case_size) };
+        copy.resize(size);
+        return copy;
     }
 
     std::vector<v2> divide_and_conquer(const std::vector<v2>& points)
+    {
+        return divide_and_conquer_on_copy(points, DIVIDE_AND_CONQUER_BASE_CASE_SIZE);
+    }
+
+    std::vector<v2> divide_and_conquer_with_base_case(const std::vector<v2>& points, int base_case_size)
+    {
+        return divide_and_conquer_on_copy(points, base_case_size);
+    }
+
+    std::vector<v2> divide_and_conquer(const point_set& points)
+    {
+        return divide_and_conquer_on_copy(points.to_points(), DIVIDE_AND_CONQUER_BASE_CASE_SIZE);
+    }
+
+    // below this many points, the recursion goes on serially: tasks would cost more than the work they carry
+    static constexpr int DIVIDE_AND_CONQUER_PARALLEL_CUTOFF{ 1 << 13 };
+
+    // same as divide_and_conquer_impl, but the two halves are computed in parallel (they write to disjoint ranges)
+    static int divide_and_conquer_parallel_impl(const v2* sorted_points, v2* out, v2* scratch, int begin, int end)
+    {
+        if (end - begin <= DIVIDE_AND_CONQUER_PARALLEL_CUTOFF)
+        {
+            trace_span span{ "recurse and merge" };
+            return divide_and_conquer_impl(sorted_points, out, scratch, begin, end, DIVIDE_AND_CONQUER_BASE_CASE_SIZE);
+        }
+        else
+        {
+            // same split as the serial version, so that the two produce the very same hull
+            int middle{ begin + (end - begin) / 2 };
+            int size_a{};
+            int size_b{};
+            fork_join(
+                [&]() { size_a = divide_and_conquer_parallel_impl(sorted_points, scratch, out, begin, middle); },
+                [&]() { size_b = divide_and_conquer_parallel_impl(sorted_points, scratch, out, middle, end); }
+            );
+            trace_span span{ "merge" };
+            return divide_and_conquer_merge(scratch + begin, size_a, scratch + middle, size_b, out + begin);
+        }
+    }
+
+    std::vector<v2> divide_and_conquer_parallel(const std::vector<v2>& points)
     {
         assert(points.size() >= 3);
 
         std::vector<v2> copy{ points };
-        std::sort(copy.begin(), copy.end(), [](v2 a, v2 b) { return a.x <= b.x; }); // sort local copy of points
-        return divide_and_conquer_impl(copy);
+        // sort local copy of points, without duplicates (see divide_and_conquer_on_copy)
+        {
+            trace_span span{ "sort" };
+            parallel_sort(copy.begin(), copy.end(), x_less<double>);
+            sort_same_x_by_y(copy);
+            copy.erase(std::unique(copy.begin(), copy.end()), copy.end());
+        }
+
+        std::vector<v2> scratch(copy.size());
+        int size{ divide_and_conquer_parallel_impl(copy.data(), copy.data(), scratch.data(), 0, static_cast<int>(copy.size())) };
+        return { copy.begin(), copy.begin() + size };
+    }
+
+    // below this many points, the akl toussaint filter stage (extremes and kill zone filtering) runs serially
+    static constexpr int AKL_TOUSSAINT_PARALLEL_CUTOFF{ 1 << 16 };
+    // smallest chunk of points handed to a thread by the parallel filter stage
+    static constexpr int AKL_TOUSSAINT_MIN_CHUNK_SIZE{ 1 << 14 };
+
+    template<typename T>
+    static int point_count(const std::vector<basic_v2<T>>& points)
+    {
+        return static_cast<int>(points.size());
+    }
+
+    static int point_count(const point_set& points)
+    {
+        return points.size();
+    }
+
+    static int point_count(std::span<const v2> points)
+    {
+        return static_cast<int>(points.size());
+    }
+
+    // coordinates stored as two arrays that are not owned, e.g. by a memory mapped point file
+    struct coordinate_arrays
+    {
+        const double* xs;
+        const double* ys;
+        int count;
+
+        v2 operator[](int i) const { return { xs[i], ys[i] }; }
+    };
+
+    static int point_count(const coordinate_arrays& points)
+    {
+        return points.count;
+    }
+
+    // type of the points read from Points (e.g. v2 for point_set, v2f for std::vector<v2f>)
+    template<typename Points>
+    using point_type = std::remove_cvref_t<decltype(std::declval<const Points&>()[0])>;
+
+    // number of chunks the filter stage splits the points into: one (i.e. serial) for small inputs
+    static int akl_toussaint_chunk_count(int count)
+    {
+        if (count < AKL_TOUSSAINT_PARALLEL_CUTOFF || thread_count() == 1)
+        {
+            return 1;
+        }
+        return std::clamp(count / AKL_TOUSSAINT_MIN_CHUNK_SIZE, 1, thread_count() * 4);
+    }
+
+    static int chunk_begin(int count, int chunk_count, int chunk)
+    {
+        return static_cast<int>(static_cast<long long>(count) * chunk / chunk_count);
+    }
+
+    struct extreme_indices
+    {
+        int xmin{};
+        int xmax{};
+        int ymin{};
+        int ymax{};
+    };
+
+    /*
+        Extreme points, with ties broken so that each of them is a hull vertex (i.e. extreme along a direction that is
+        slightly tilted from the axis): leftmost and rightmost are the lexicographic minimum and maximum, topmost is the
+        leftmost of the highest points and bottommost is the rightmost of the lowest ones.
+        The first test is the only one that almost every point gets to, so that the tie breaking costs no more than the
+        plain comparison of one coordinate (spelled as lexicographic_less, the scan of the extremes was about 1.5x slower).
+    */
+    template<typename T>
+    static bool more_left(basic_v2<T> p, basic_v2<T> extreme)
+    {
+        return p.x <= extreme.x && (p.x < extreme.x || p.y < extreme.y);
+    }
+
+    template<typename T>
+    static bool more_right(basic_v2<T> p, basic_v2<T> extreme)
+    {
+        return p.x >= extreme.x && (p.x > extreme.x || p.y > extreme.y);
+    }
+
+    template<typename T>
+    static bool more_top(basic_v2<T> p, basic_v2<T> extreme)
+    {
+        return p.y >= extreme.y && (p.y > extreme.y || p.x < extreme.x);
+    }
+
+    template<typename T>
+    static bool more_bottom(basic_v2<T> p, basic_v2<T> extreme)
+    {
+        return p.y <= extreme.y && (p.y < extreme.y || p.x > extreme.x);
     }
 
-    static std::vector<v2> build_kill_zone(const std::vector<v2> points)
+    // finds the four extreme points of points[begin, end) in a single pass
+    template<typename Points>
+    static extreme_indices find_extremes(const Points& points, int begin, int end)
     {
-        v2 xmin{};
-        v2 xmax{};
+        assert(begin < end);
+
+        extreme_indices extremes{ begin, begin, begin, begin };
+        point_type<Points> xmin{ points[begin] }, xmax{ xmin }, ymin{ xmin }, ymax{ xmin };
+        for (int i{ begin + 1 }; i < end; i++)
         {
-            auto it{ std::minmax_element(points.begin(), points.end(), [](const v2& a, const v2& b) { return a.x < b.x; }) };
-            assert(it.first != points.end());
-            assert(it.second != points.end());
-            xmin = *it.first;
-            xmax = *it.second;
+            point_type<Points> p{ points[i] };
+            if (more_left(p, xmin)) { xmin = p; extremes.xmin = i; }
+            if (more_right(p, xmax)) { xmax = p; extremes.xmax = i; }
+            if (more_bottom(p, ymin)) { ymin = p; extremes.ymin = i; }
+            if (more_top(p, ymax)) { ymax = p; extremes.ymax = i; }
         }
-        v2 ymin{};
-        v2 ymax{};
+        return extremes;
+    }
+
+    // merges the extremes of two consecutive ranges (a comes first), with the same tie breaking as find_extremes
+    template<typename Points>
+    static extreme_indices merge_extremes(const Points& points, extreme_indices a, extreme_indices b)
+    {
+        return
+        {
+            more_left(points[b.xmin], points[a.xmin]) ? b.xmin : a.xmin,
+            more_right(points[b.xmax], points[a.xmax]) ? b.xmax : a.xmax,
+            more_bottom(points[b.ymin], points[a.ymin]) ? b.ymin : a.ymin,
+            more_top(points[b.ymax], points[a.ymax]) ? b.ymax : a.ymax,
+        };
+    }
+
+    // the kill zone is the quadrilateral with the four extreme points as vertices (which may be less than four, if some coincide)
+    template<typename Points>
+    static std::vector<point_type<Points>> build_kill_zone(const Points& points)
+    {
+        trace_span span{ "extremes" };
+
+        int count{ point_count(points) };
+        assert(count > 0);
+
+        // chunked reduction: the extremes of each chunk are found in parallel, then merged in chunk order
+        int chunk_count{ akl_toussaint_chunk_count(count) };
+        std::vector<extreme_indices> chunk_extremes(chunk_count);
+        parallel_for(chunk_count, [&](int begin, int end)
+        {
+            for (int chunk{ begin }; chunk < end; chunk++)
+            {
+                chunk_extremes[chunk] = find_extremes(points, chunk_begin(count, chunk_count, chunk), chunk_begin(count, chunk_count, chunk + 1));
+            }
+        });
+        extreme_indices extremes{ chunk_extremes[0] };
+        for (int chunk{ 1 }; chunk < chunk_count; chunk++)
         {
-            auto it{ std::minmax_element(points.begin(), points.end(), [](const v2& a, const v2& b) { return a.y < b.y; }) };
-            assert(it.first != points.end());
-            assert(it.second != points.end());
-            ymin = *it.first;
-            ymax = *it.second;
+            extremes = merge_extremes(points, extremes, chunk_extremes[chunk]);
         }
 
-        std::vector<v2> kill_zone{};
+        std::vector<point_type<Points>> kill_zone{};
         {
-            v2 quadrilateral[4]{ xmin, ymax, xmax, ymin };
-            for (v2 p : quadrilateral)
+            point_type<Points> quadrilateral[4]{ points[extremes.xmin], points[extremes.ymax], points[extremes.xmax], points[extremes.ymin] };
+            for (point_type<Points> p : quadrilateral)
             {
                 if (auto it{ std::find(kill_zone.begin(), kill_zone.end(), p) }; it == kill_zone.end())
                 {
@@ -276,200 +625,325 @@ namespace ch
         return kill_zone;
     }
 
+    // whether p lies strictly to the left of from -> to, i.e. strictly outside of that side of the clockwise kill zone
+    template<typename T>
+    static bool falls_within_region(basic_v2<T> p, basic_v2<T> from, basic_v2<T> to)
+    {
+        return orientation(from, to, p) > 0;
+    }
+
+    template<typename T, typename Planes>
+    static int filter_kill_zone(const std::vector<basic_v2<T>>& points, int begin, int end, const Planes& planes, basic_v2<T>* survivors)
+    {
+        return filter_kill_zone(points.data() + begin, end - begin, planes, survivors);
+    }
+
+    static int filter_kill_zone(const point_set& points, int begin, int end, const kill_zone_planes& planes, v2* survivors)
+    {
+        return filter_kill_zone(points.xs() + begin, points.ys() + begin, end - begin, planes, survivors);
+    }
+
+    static int filter_kill_zone(std::span<const v2> points, int begin, int end, const kill_zone_planes& planes, v2* survivors)
+    {
+        return filter_kill_zone(points.data() + begin, end - begin, planes, survivors);
+    }
+
+    static int filter_kill_zone(const coordinate_arrays& points, int begin, int end, const kill_zone_planes& planes, v2* survivors)
+    {
+        return filter_kill_zone(points.xs + begin, points.ys + begin, end - begin, planes, survivors);
+    }
+
     /*
-        A point falls within the kill zone, if all the half plane tests give back a negative dot product.
-        We do one half plane test for each side of the killzone.
+        Appends to survivors the points of points[begin, end) that don't fall within the kill zone.
+        Points are filtered block by block through a small buffer, so that memory traffic is proportional to the survivors only.
     */
-    static bool falls_within_kill_zone(v2 p, const std::vector<v2>& kill_zone)
+    template<typename Points, typename Planes>
+    static void akl_toussaint_heuristic(const Points& points, int begin, int end, const Planes& planes, std::vector<point_type<Points>>& survivors)
     {
-        bool falls_within{ true };
-        for (int i{}; i < static_cast<int>(kill_zone.size()) && falls_within; i++)
+        constexpr int BLOCK_SIZE{ 1024 };
+        point_type<Points> block_survivors[BLOCK_SIZE]{};
+        for (int block_begin{ begin }; block_begin < end; block_begin += BLOCK_SIZE)
         {
-            v2 from{ kill_zone[i] };
-            v2 to{ kill_zone[(i + 1) % static_cast<int>(kill_zone.size())] };
-            v2 from_to{ to - from };
-            v2 normal{ v2::normal(from_to) };
-            v2 from_p{ p - from };
-            falls_within = v2::dot(normal, from_p) < 0;
+            int block_end{ std::min(block_begin + BLOCK_SIZE, end) };
+            int survivors_count{ filter_kill_zone(points, block_begin, block_end, planes, block_survivors) };
+            survivors.insert(survivors.end(), block_survivors, block_survivors + survivors_count);
+            count_hull_stat(hull_counter::kill_zone_survivors, survivors_count);
+            count_hull_stat(hull_counter::kill_zone_discarded, block_end - block_begin - survivors_count);
         }
-        return falls_within;
     }
 
-    static bool falls_within_region(v2 p, v2 from, v2 to)
+    template<typename Points>
+    static std::vector<point_type<Points>> akl_toussaint_heuristic(const Points& points, const std::vector<point_type<Points>>& kill_zone)
     {
-        v2 from_to{ to - from };
-        v2 normal{ v2::normal(from_to) };
-        v2 from_p{ p - from };
-        return v2::dot(normal, from_p) > 0;
-    }
+        trace_span span{ "filter" };
 
-    static std::vector<v2> akl_toussaint_heuristic(const std::vector<v2>& points, const std::vector<v2> kill_zone)
-    {
         // apply heuristic, i.e. filter points that fall within the kill zone
-        std::vector<v2> survivors{};
-        for (v2 p : points)
+        int count{ point_count(points) };
+        auto planes{ make_kill_zone_planes(kill_zone) };
+        int chunk_count{ akl_toussaint_chunk_count(count) };
+        if (chunk_count == 1)
         {
-            if (!falls_within_kill_zone(p, kill_zone))
+            std::vector<point_type<Points>> survivors{};
+            akl_toussaint_heuristic(points, 0, count, planes, survivors);
+            return survivors;
+        }
+
+        // each chunk is filtered in parallel in its own buffer, then buffers are concatenated in chunk order
+        std::vector<std::vector<point_type<Points>>> chunk_survivors(chunk_count);
+        parallel_for(chunk_count, [&](int begin, int end)
+        {
+            for (int chunk{ begin }; chunk < end; chunk++)
             {
-                survivors.emplace_back(p);
+                trace_span chunk_span{ "filter chunk" };
+                akl_toussaint_heuristic(points, chunk_begin(count, chunk_count, chunk), chunk_begin(count, chunk_count, chunk + 1), planes, chunk_survivors[chunk]);
             }
+        });
+
+        size_t survivors_count{};
+        for (const auto& survivors : chunk_survivors)
+        {
+            survivors_count += survivors.size();
+        }
+        std::vector<point_type<Points>> survivors{};
+        survivors.reserve(survivors_count);
+        for (const auto& chunk : chunk_survivors)
+        {
+            survivors.insert(survivors.end(), chunk.begin(), chunk.end());
         }
         return survivors;
     }
 
-    static std::vector<v2> akl_toussaint_impl(const std::vector<v2>& points)
+    /*
+        Convexifies in place the polyline path[0, count), whose vertices are sorted along the direction of travel, and returns
+        the size of the resulting convex path. Both extremes are kept, while collinear (and duplicate) vertices are dropped.
+        It is a single pass with a stack (as in Andrew's monotone chain): each vertex is pushed once and popped at most once,
+        as soon as it doesn't make a strict right turn with the vertex that comes after it.
+    */
+    template<typename T>
+    static int convexify_path(basic_v2<T>* path, int count)
     {
-        // apply akl toussaint heuristic
-        std::vector<v2> kill_zone{ build_kill_zone(points) };
-        std::vector<v2> survivors{ akl_toussaint_heuristic(points, kill_zone) };
+        int size{};
+        int restarts{};
+        for (int i{}; i < count; i++)
+        {
+            basic_v2<T> p{ path[i] };
+            int size_before{ size };
+            while (size >= 2 && orientation(path[size - 2], path[size - 1], p) >= 0) // concave or collinear triplet
+            {
+                size--;
+            }
+            restarts += size != size_before;
+            path[size++] = p;
+        }
+        count_hull_stat(hull_counter::convexify_deletions, count - size);
+        count_hull_stat(hull_counter::convexify_restarts, restarts);
+        return size;
+    }
 
-        // build hull on survivor point set
-        std::vector<v2> hull{};
+    // builds the hull region by region, from the points that survived the akl toussaint heuristic
+    template<typename T>
+    static std::vector<basic_v2<T>> akl_toussaint_hull(const std::vector<basic_v2<T>>& kill_zone, const std::vector<basic_v2<T>>& survivors)
+    {
+        std::vector<basic_v2<T>> hull{};
         {
             for (int i{}; i < static_cast<int>(kill_zone.size()); i++)
             {
-                v2 from{ kill_zone[i] };
-                v2 to{ kill_zone[(i + 1) % static_cast<int>(kill_zone.size())] };
+                basic_v2<T> from{ kill_zone[i] };
+                basic_v2<T> to{ kill_zone[(i + 1) % static_cast<int>(kill_zone.size())] };
 
                 // find points belonging to the region (including "from" and "to")
-                std::vector<v2> region_points{};
-                region_points.emplace_back(from);
-                region_points.emplace_back(to);
-                for (v2 p : survivors)
+                std::vector<basic_v2<T>> region_points{};
                 {
-                    if (falls_within_region(p, from, to))
+                    trace_span span{ "region split" };
+                    region_points.emplace_back(from);
+                    region_points.emplace_back(to);
+                    for (basic_v2<T> p : survivors)
                     {
-                        region_points.emplace_back(p);
+                        if (falls_within_region(p, from, to))
+                        {
+                            region_points.emplace_back(p);
+                        }
                     }
                 }
 
-                // sort points
+                /*
+                    Sort points. Regions 1 and 2 (from the leftmost to the rightmost point, through the topmost one) are on
+                    the upper hull, which goes in lexicographic order. Regions 3 and 4 are on the lower hull, which goes in
+                    reverse lexicographic order.
+                */
                 {
-                    v2 from_to{ to - from };
-                    assert(from_to.x != 0); // no two points can have the same x
-                    if (from_to.x > 0)
+                    trace_span span{ "sort" };
+                    if (lexicographic_less(from, to))
                     {
-                        // we either are in region 1 or 2
-                        std::sort(region_points.begin(), region_points.end(), [](v2 a, v2 b) { return a.x <= b.x; });
+                        std::sort(region_points.begin(), region_points.end(), lexicographic_less<T>);
                     }
-                    else if (from_to.x < 0)
+                    else
                     {
-                        // we either are in region 3 or 4
-                        std::sort(region_points.begin(), region_points.end(), [](v2 a, v2 b) { return a.x >= b.x; });
+                        std::sort(region_points.begin(), region_points.end(), [](basic_v2<T> a, basic_v2<T> b) { return lexicographic_less(b, a); });
                     }
                 }
 
                 // find convex path that goes from "from" to "to"
+                int path_size{};
                 {
-                    while (true)
-                    {
-                        assert(region_points.size() >= 2);
-
-                        bool was_there_any_deletion{ false };
-                        int k{};
-                        while (0 <= k && k < (static_cast<int>(region_points.size()) - 2))
-                        {
-                            v2 p{ region_points[k] };
-                            v2 pn{ region_points[k + 1] };
-                            v2 pnn{ region_points[k + 2] };
-                            double s{ determinant(pnn - pn, pn - p) };
-                            if (s >= 0) // convex triplet
-                            {
-                                k++;
-                            }
-                            else // concave triplet
-                            {
-                                region_points.erase(region_points.begin() + k + 1);
-                                was_there_any_deletion = true;
-                                k--;
-                            }
-                        }
-
-                        if (!was_there_any_deletion)
-                        {
-                            break;
-                        }
-                    }
+                    trace_span span{ "convexify" };
+                    path_size = convexify_path(region_points.data(), static_cast<int>(region_points.size()));
                 }
 
-                // append convex path to hull
-                for (v2 p : region_points)
-                {
-                    // we built region_points inserting the extreme points related to the region.
-                    // the problem is that extreme points are shared between neighboring regions.
-                    // thus, before inserting any point in the hull, we check for duplicates.
-                    // for such diplicate points, we simply don't insert them in the hull.
-                    if (auto it{ std::find(hull.begin(), hull.end(), p) }; it == hull.end())
-                    {
-                        hull.emplace_back(p);
-                    }
-                }
+                // append convex path to hull.
+                // "to" is the "from" of the next region (the last "to" is the very first "from"), so it is left to the next region
+                hull.insert(hull.end(), region_points.begin(), region_points.begin() + path_size - 1);
             }
         }
         return hull;
     }
 
-    std::vector<v2> akl_toussaint(const std::vector<v2>& points)
+    template<typename T>
+    static std::vector<basic_v2<T>> akl_toussaint_impl(const std::vector<basic_v2<T>>& points)
     {
         assert(points.size() >= 3);
 
-        std::vector<v2> copy{ points };
-        if (points.size() == 3)
+        if (points.size() == 3 && orientation(points[0], points[1], points[2]) != 0)
         {
+            std::vector<basic_v2<T>> copy{ points };
             if (!is_hull_clockwise(points))
             {
                 std::reverse(copy.begin(), copy.end());
             }
             return copy;
         }
-        else
-        {
-            return akl_toussaint_impl(copy);
-        }
+
+        // apply akl toussaint heuristic
+        std::vector<basic_v2<T>> kill_zone{ build_kill_zone(points) };
+        std::vector<basic_v2<T>> survivors{ akl_toussaint_heuristic(points, kill_zone) };
+
+        // build hull on survivor point set
+        return akl_toussaint_hull(kill_zone, survivors);
     }
 
-    std::vector<v2> torch(const std::vector<v2>& points)
+    std::vector<v2> akl_toussaint(const std::vector<v2>& points)
     {
-        assert(points.size() > 3);
+        return akl_toussaint_impl(points);
+    }
 
-        std::vector<v2> copy{ points };
+    std::vector<v2f> akl_toussaint(const std::vector<v2f>& points)
+    {
+        return akl_toussaint_impl(points);
+    }
 
-        // sort point set in x direction
-        std::sort(copy.begin(), copy.end(), [](v2 a, v2 b) { return a.x <= b.x; });
+    std::vector<v2i> akl_toussaint(const std::vector<v2i>& points)
+    {
+        return akl_toussaint_impl(points);
+    }
 
-        // find the leftmost (west) and rightmost (east) points
-        int west_idx{ 0 };
-        int east_idx{ static_cast<int>(copy.size() - 1) };
+    // akl toussaint straight on points that are read in place, without copying them first
+    template<typename Points>
+    static std::vector<v2> akl_toussaint_in_place(const Points& points)
+    {
+        assert(point_count(points) > 3);
 
-        // find the lowermost (south) and uppermost (north) points
-        int south_idx{};
-        int north_idx{};
+        // apply akl toussaint heuristic
+        std::vector<v2> kill_zone{ build_kill_zone(points) };
+        std::vector<v2> survivors{ akl_toussaint_heuristic(points, kill_zone) };
+
+        // build hull on survivor point set
+        return akl_toussaint_hull(kill_zone, survivors);
+    }
+
+    std::vector<v2> akl_toussaint(const point_set& points)
+    {
+        assert(points.size() >= 3);
+
+        if (points.size() == 3)
         {
-            auto it{ std::minmax_element(copy.begin(), copy.end(), [](v2 a, v2 b) { return a.y <= b.y; }) };
-            assert(it.first != copy.end());
-            assert(it.second != copy.end());
-            south_idx = static_cast<int>(std::distance(copy.begin(), it.first));
-            north_idx = static_cast<int>(std::distance(copy.begin(), it.second));
-            assert(south_idx >= 0);
-            assert(north_idx >= 0);
+            return akl_toussaint(points.to_points());
         }
-
-        // find south west hull (from west to south)
-        std::vector<int> south_west{};
+        else
         {
-            double min_y{ copy[west_idx].y };
-            south_west.emplace_back(west_idx);
-            for (int i{ west_idx + 1 }; i <= south_idx; i++)
-            {
-                if (copy[i].y <= min_y)
-                {
-                    min_y = copy[i].y;
-                    south_west.emplace_back(i);
-                }
-            }
+            return akl_toussaint_in_place(points);
         }
+    }
 
-        // find south east hull (from east to south)
+    std::vector<v2> akl_toussaint(std::span<const v2> points)
+    {
+        assert(points.size() >= 3);
+
+        if (points.size() == 3)
+        {
+            return akl_toussaint(std::vector<v2>{ points.begin(), points.end() });
+        }
+        else
+        {
+            return akl_toussaint_in_place(points);
+        }
+    }
+
+    std::vector<v2> akl_toussaint(std::span<const double> xs, std::span<const double> ys)
+    {
+        assert(xs.size() == ys.size());
+        assert(xs.size() >= 3);
+
+        coordinate_arrays points{ xs.data(), ys.data(), static_cast<int>(xs.size()) };
+        if (xs.size() == 3)
+        {
+            return akl_toussaint(std::vector<v2>{ points[0], points[1], points[2] });
+        }
+        else
+        {
+            return akl_toussaint_in_place(points);
+        }
+    }
+
+    // torch on a local copy of the points, which gets sorted in place
+    static std::vector<v2> torch_on_copy(std::vector<v2> copy)
+    {
+        assert(copy.size() >= 3);
+
+        // sort point set in lexicographic order
+        {
+            trace_span span{ "sort" };
+            sort_lexicographic(copy);
+        }
+
+        // find the leftmost (west) and rightmost (east) points
+        int west_idx{ 0 };
+        int east_idx{ static_cast<int>(copy.size() - 1) };
+        if (copy[west_idx] == copy[east_idx])
+        {
+            return { copy[west_idx] }; // all the points are the same
+        }
+
+        trace_span staircases_span{ "staircases" };
+
+        // find the lowermost (south) and uppermost (north) points
+        int south_idx{};
+        int north_idx{};
+        {
+            auto it{ std::minmax_element(copy.begin(), copy.end(), [](v2 a, v2 b) { return a.y < b.y; }) };
+            assert(it.first != copy.end());
+            assert(it.second != copy.end());
+            south_idx = static_cast<int>(std::distance(copy.begin(), it.first));
+            north_idx = static_cast<int>(std::distance(copy.begin(), it.second));
+            assert(south_idx >= 0);
+            assert(north_idx >= 0);
+        }
+
+        // find south west hull (from west to south)
+        std::vector<int> south_west{};
+        {
+            double min_y{ copy[west_idx].y };
+            south_west.emplace_back(west_idx);
+            for (int i{ west_idx + 1 }; i <= south_idx; i++)
+            {
+                if (copy[i].y <= min_y)
+                {
+                    min_y = copy[i].y;
+                    south_west.emplace_back(i);
+                }
+            }
+        }
+
+        // find south east hull (from east to south)
         std::vector<int> south_east{};
         {
             double min_y{ copy[east_idx].y };
@@ -514,57 +988,835 @@ namespace ch
             }
         }
 
+        // upper path goes from west to east (through north), lower path goes from east to west (through south)
+        std::vector<v2> upper{};
+        {
+            for (int i{}; i < static_cast<int>(north_west.size()); i++)
+            {
+                upper.emplace_back(copy[north_west[i]]);
+            }
+            for (int i{ static_cast<int>(north_east.size()) - 2 }; i >= 0; i--)
+            {
+                upper.emplace_back(copy[north_east[i]]);
+            }
+        }
+        std::vector<v2> lower{};
+        {
+            for (int i{}; i < static_cast<int>(south_east.size()); i++)
+            {
+                lower.emplace_back(copy[south_east[i]]);
+            }
+            for (int i{ static_cast<int>(south_west.size()) - 2 }; i >= 0; i--)
+            {
+                lower.emplace_back(copy[south_west[i]]);
+            }
+        }
+
+        // convexification (east and west are shared by the two paths, so each path leaves out its last point)
+        staircases_span.stop();
+        trace_span convexify_span{ "convexify" };
+        int upper_size{ convexify_path(upper.data(), static_cast<int>(upper.size())) };
+        int lower_size{ convexify_path(lower.data(), static_cast<int>(lower.size())) };
         std::vector<v2> hull{};
+        hull.reserve(upper_size + lower_size - 2);
+        hull.insert(hull.end(), upper.begin(), upper.begin() + upper_size - 1);
+        hull.insert(hull.end(), lower.begin(), lower.begin() + lower_size - 1);
+
+        return hull;
+    }
+
+    std::vector<v2> torch(const std::vector<v2>& points)
+    {
+        return torch_on_copy(points);
+    }
+
+    std::vector<v2> torch(const point_set& points)
+    {
+        return torch_on_copy(points.to_points());
+    }
+
+    template<typename T>
+    static std::vector<basic_v2<T>> monotone_chain_impl(const std::vector<basic_v2<T>>& points)
+    {
+        assert(points.size() >= 3);
+
+        std::vector<basic_v2<T>> copy{ points };
+        {
+            trace_span span{ "sort" };
+            sort_lexicographic(copy); // sort local copy of points
+        }
+        if (copy.front() == copy.back())
+        {
+            return { copy.front() }; // all the points are the same
+        }
+
+        trace_span span{ "convexify" };
+        std::vector<basic_v2<T>> hull(2 * copy.size());
+        hull.resize(monotone_chain_sorted(copy.data(), static_cast<int>(copy.size()), hull.data()));
+        return hull;
+    }
+
+    std::vector<v2> monotone_chain(const std::vector<v2>& points)
+    {
+        return monotone_chain_impl(points);
+    }
+
+    std::vector<v2f> monotone_chain(const std::vector<v2f>& points)
+    {
+        return monotone_chain_impl(points);
+    }
+
+    std::vector<v2i> monotone_chain(const std::vector<v2i>& points)
+    {
+        return monotone_chain_impl(points);
+    }
+
+    /*
+        Sign of dot(b - a, d - c), for b - a parallel to d - c. The two products have the same sign, so the sign is exact
+        even though they are rounded. It is evaluated in double precision, where int32 differences can't overflow.
+    */
+    template<typename T>
+    static double parallel_dot(basic_v2<T> a, basic_v2<T> b, basic_v2<T> c, basic_v2<T> d)
+    {
+        double x{ (static_cast<double>(b.x) - a.x) * (static_cast<double>(d.x) - c.x) };
+        double y{ (static_cast<double>(b.y) - a.y) * (static_cast<double>(d.y) - c.y) };
+        return x + y;
+    }
+
+    // below this many points, quickhull sub-problems are solved serially
+    static constexpr int QUICKHULL_PARALLEL_CUTOFF{ 1 << 13 };
+
+    /*
+        Hull vertices strictly between a and b, for the points [begin, end) that all lie strictly outside of the edge a -> b.
+        The farthest point c from the edge is a hull vertex: points outside of a -> c and outside of c -> b are partitioned
+        in place to the front of the range, while the others (c included) can't be hull vertices and are dropped.
+        The clockwise hull vertices are written to the front of the range, and their number is returned: since they are
+        a subset of the range, they always fit.
+    */
+    template<typename T>
+    static int quickhull_impl(basic_v2<T>* begin, basic_v2<T>* end, basic_v2<T> a, basic_v2<T> b)
+    {
+        if (begin == end)
+        {
+            return 0;
+        }
+
+        /*
+            Find farthest point from a -> b. p is farther than c if c -> p turns counterclockwise from a -> b. Among the
+            points at the same distance, the one that comes first along a -> b is taken: only the first and the last of
+            them are hull vertices. Since c -> p and a -> b are then parallel, the sign of the dot product is exact.
+        */
+        basic_v2<T> c{ *begin };
+        for (basic_v2<T>* it{ begin + 1 }; it != end; it++)
         {
-            for (int i{}; i < static_cast<int>(north_west.size()) - 1; i++)
+            double farther{ orientation(a, b, c, *it) };
+            if (farther > 0 || (farther == 0 && parallel_dot(c, *it, a, b) < 0))
             {
-                hull.emplace_back(copy[north_west[i]]);
+                c = *it;
             }
-            for (int i{ static_cast<int>(north_east.size()) - 1 }; i > 0; i--)
+        }
+
+        // partition in place: [begin, middle) lies outside of a -> c, [middle, last) lies outside of c -> b
+        basic_v2<T>* middle{ std::partition(begin, end, [=](basic_v2<T> p) { return falls_within_region(p, a, c); }) };
+        basic_v2<T>* last{ std::partition(middle, end, [=](basic_v2<T> p) { return falls_within_region(p, c, b); }) };
+
+        int size_a{};
+        int size_b{};
+        if (last - begin <= QUICKHULL_PARALLEL_CUTOFF)
+        {
+            size_a = quickhull_impl(begin, middle, a, c);
+            size_b = quickhull_impl(middle, last, c, b);
+        }
+        else
+        {
+            fork_join(
+                [&]() { size_a = quickhull_impl(begin, middle, a, c); },
+                [&]() { size_b = quickhull_impl(middle, last, c, b); }
+            );
+        }
+
+        // vertices from a to c, c, vertices from c to b (c was among the dropped points, so there is room for it)
+        std::memmove(begin + size_a + 1, middle, size_b * sizeof(basic_v2<T>));
+        begin[size_a] = c;
+        return size_a + 1 + size_b;
+    }
+
+    template<typename T>
+    static std::vector<basic_v2<T>> quickhull_seeded(const std::vector<basic_v2<T>>& points)
+    {
+        assert(points.size() >= 3);
+
+        // seed partition: the kill zone quadrilateral, with its inside dropped by the akl toussaint heuristic
+        std::vector<basic_v2<T>> kill_zone{ build_kill_zone(points) };
+        std::vector<basic_v2<T>> survivors{ akl_toussaint_heuristic(points, kill_zone) };
+
+        // partition survivors in place, one region (i.e. one side of the kill zone) after the other
+        int region_count{ static_cast<int>(kill_zone.size()) };
+        std::vector<basic_v2<T>*> region_bounds(region_count + 1);
+        region_bounds[0] = survivors.data();
+        {
+            trace_span span{ "region split" };
+            for (int i{}; i < region_count; i++)
             {
-                hull.emplace_back(copy[north_east[i]]);
+                basic_v2<T> from{ kill_zone[i] };
+                basic_v2<T> to{ kill_zone[(i + 1) % region_count] };
+                region_bounds[i + 1] = std::partition(region_bounds[i], survivors.data() + survivors.size(), [=](basic_v2<T> p) { return falls_within_region(p, from, to); });
             }
-            for (int i{}; i < static_cast<int>(south_east.size()) - 1; i++)
+        }
+
+        // solve the regions in parallel
+        std::vector<int> region_sizes(region_count);
+        parallel_for(region_count, [&](int begin, int end)
+        {
+            for (int i{ begin }; i < end; i++)
             {
-                hull.emplace_back(copy[south_east[i]]);
+                trace_span span{ "quickhull region" };
+                region_sizes[i] = quickhull_impl(region_bounds[i], region_bounds[i + 1], kill_zone[i], kill_zone[(i + 1) % region_count]);
             }
-            for (int i{ static_cast<int>(south_west.size()) - 1 }; i > 0; i--)
+        });
+
+        std::vector<basic_v2<T>> hull{};
+        for (int i{}; i < region_count; i++)
+        {
+            hull.emplace_back(kill_zone[i]);
+            hull.insert(hull.end(), region_bounds[i], region_bounds[i] + region_sizes[i]);
+        }
+        return hull;
+    }
+
+    std::vector<v2> quickhull(const std::vector<v2>& points)
+    {
+        return quickhull_seeded(points);
+    }
+
+    std::vector<v2f> quickhull(const std::vector<v2f>& points)
+    {
+        return quickhull_seeded(points);
+    }
+
+    std::vector<v2i> quickhull(const std::vector<v2i>& points)
+    {
+        return quickhull_seeded(points);
+    }
+
+    /*
+        As the next hull vertex after p, is r better than q? (i.e. more to the left, or collinear and farther)
+        If p, q and r are collinear, q -> r and p -> q are parallel: the sign of their dot product is exact.
+    */
+    static bool chan_is_better(v2 p, v2 q, v2 r)
+    {
+        double side{ orientation(p, q, r) };
+        return side > 0 || (side == 0 && q != p && v2::dot(r - q, q - p) > 0) || (q == p && r != p);
+    }
+
+    /*
+        Index of the vertex t of the clockwise convex polygon hull[0, size) such that no vertex lies to the left of p -> t.
+        p must lie outside of the polygon. Seen from p, the "leftness" of the vertices goes up and down only once around the
+        polygon, thus its maximum can be found with a binary search on the cyclic sequence, in O(log size).
+    */
+    static int chan_tangent_search(const v2* hull, int size, v2 p)
+    {
+        // is b strictly to the left of p -> a?
+        auto more_left{ [=](v2 a, v2 b) { return orientation(p, a, b) > 0; } };
+
+        if (size <= 3)
+        {
+            int t{};
+            for (int i{ 1 }; i < size; i++)
             {
-                hull.emplace_back(copy[south_west[i]]);
+                t = more_left(hull[t], hull[i]) ? i : t;
             }
+            return t;
+        }
+
+        // does the leftness go up from i to i + 1? (0 <= i < size)
+        auto up{ [&](int i) { return more_left(hull[i], hull[i + 1 == size ? 0 : i + 1]); } };
+        // is i a maximum? (0 <= i < size)
+        auto is_tangent{ [&](int i) { return !up(i) && !more_left(hull[i], hull[i == 0 ? size - 1 : i - 1]); } };
+
+        if (is_tangent(0))
+        {
+            return 0;
         }
 
-        // convexification
+        // the maximum lies strictly between a and b
+        int a{ 0 };
+        int b{ size };
+        while (b - a > 1)
+        {
+            int c{ a + (b - a) / 2 };
+            if (is_tangent(c))
+            {
+                return c;
+            }
+
+            bool up_a{ up(a) };
+            bool up_c{ up(c) };
+            if (up_a)
+            {
+                // leftness goes up at a: the maximum comes after c only if c is on the same rising run as a
+                if (up_c && more_left(hull[a], hull[c]))
+                {
+                    a = c;
+                }
+                else
+                {
+                    b = c;
+                }
+            }
+            else
+            {
+                // leftness goes down at a: the maximum comes before c only if c is on the falling run that follows it
+                if (!up_c && more_left(hull[a], hull[c]))
+                {
+                    b = c;
+                }
+                else
+                {
+                    a = c;
+                }
+            }
+        }
+
+        // only reached on degenerate (collinear) inputs, where leftness has plateaus
+        int t{};
+        for (int i{ 1 }; i < size; i++)
+        {
+            t = more_left(hull[t], hull[i]) ? i : t;
+        }
+        return t;
+    }
+
+    /*
+        chan_tangent_search, taking care of the degenerate cases as well: if p is a vertex of the polygon (i.e. p has a
+        duplicate in the group), the tangent is the clockwise vertex after it. If two vertices are collinear with p, the
+        farther one is the tangent: for a convex polygon, the two are next to each other.
+    */
+    static int chan_tangent(const v2* hull, int size, v2 p)
+    {
+        int t{ chan_tangent_search(hull, size, p) };
+        if (hull[t] == p)
+        {
+            return (t + 1) % size;
+        }
+        for (int neighbor : { (t + 1) % size, (t + size - 1) % size })
+        {
+            if (chan_is_better(p, hull[t], hull[neighbor]))
+            {
+                return neighbor;
+            }
+        }
+        return t;
+    }
+
+    // hulls of consecutive groups of m points: group i is stored in hulls[i * m, i * m + sizes[i])
+    struct chan_groups
+    {
+        int m{};
+        std::vector<v2> hulls{};
+        std::vector<int> sizes{};
+    };
+
+    /*
+        Computes the hulls of groups of m points, in parallel.
+        If previous is given (with previous->m dividing m, or m == points count), a group is the union of whole previous groups,
+        so its hull is computed from their hulls only, instead of from all of its points.
+    */
+    static chan_groups chan_group_hulls(const std::vector<v2>& points, int m, const chan_groups* previous)
+    {
+        int count{ static_cast<int>(points.size()) };
+        int group_count{ (count + m - 1) / m };
+
+        chan_groups groups{ m, std::vector<v2>(points.size()), std::vector<int>(group_count) };
+        parallel_for(group_count, [&](int begin, int end)
+        {
+            trace_span span{ "group hulls" };
+            std::vector<v2> group_points{};
+            for (int i{ begin }; i < end; i++)
+            {
+                int group_begin{ i * m };
+                int group_end{ std::min(group_begin + m, count) };
+
+                group_points.clear();
+                if (previous)
+                {
+                    assert(group_begin % previous->m == 0);
+                    for (int j{ group_begin / previous->m }; j * previous->m < group_end; j++)
+                    {
+                        auto previous_hull{ previous->hulls.begin() + j * previous->m };
+                        group_points.insert(group_points.end(), previous_hull, previous_hull + previous->sizes[j]);
+                    }
+                }
+                else
+                {
+                    group_points.assign(points.begin() + group_begin, points.begin() + group_end);
+                }
+
+                if (group_points.size() >= 3)
+                {
+                    group_points = akl_toussaint(group_points);
+                }
+                std::copy(group_points.begin(), group_points.end(), groups.hulls.begin() + group_begin);
+                groups.sizes[i] = static_cast<int>(group_points.size());
+            }
+        });
+        return groups;
+    }
+
+    struct chan_vertex
+    {
+        int group{};
+        int vertex{};
+    };
+
+    // below this many groups, the tangents of a gift wrapping step are searched serially
+    static constexpr int CHAN_PARALLEL_WRAP_CUTOFF{ 1 << 10 };
+
+    static bool chan_is_better(const chan_groups& groups, v2 p, chan_vertex best, chan_vertex candidate)
+    {
+        v2 q{ groups.hulls[best.group * groups.m + best.vertex] };
+        v2 r{ groups.hulls[candidate.group * groups.m + candidate.vertex] };
+        return chan_is_better(p, q, r);
+    }
+
+    // best next hull vertex after p (that is vertex "current" of its group), among best and the tangents from p to groups [begin, end)
+    static chan_vertex chan_next_vertex(const chan_groups& groups, chan_vertex current, int begin, int end, chan_vertex best)
+    {
+        int m{ groups.m };
+        v2 p{ groups.hulls[current.group * m + current.vertex] };
+        for (int i{ begin }; i < end; i++)
+        {
+            if (i == current.group)
+            {
+                continue;
+            }
+
+            chan_vertex candidate{ i, chan_tangent(groups.hulls.data() + i * m, groups.sizes[i], p) };
+            if (chan_is_better(groups, p, best, candidate))
+            {
+                best = candidate;
+            }
+        }
+        return best;
+    }
+
+    /*
+        Gift wrapping on the group hulls, for at most m steps.
+        Returns false (and leaves hull empty) if the hull has more than m vertices.
+    */
+    static bool chan_wrap(const chan_groups& groups, std::vector<v2>& hull)
+    {
+        int m{ groups.m };
+        int group_count{ static_cast<int>(groups.sizes.size()) };
+
+        // start from the leftmost point (which is on some group hull)
+        chan_vertex current{};
+        for (int i{}; i < group_count; i++)
+        {
+            for (int j{}; j < groups.sizes[i]; j++)
+            {
+                v2 best{ groups.hulls[current.group * m + current.vertex] };
+                v2 p{ groups.hulls[i * m + j] };
+                if (p.x < best.x || (p.x == best.x && p.y < best.y))
+                {
+                    current = { i, j };
+                }
+            }
+        }
+
+        int chunk_count{ group_count < CHAN_PARALLEL_WRAP_CUTOFF ? 1 : thread_count() * 4 };
+        std::vector<chan_vertex> chunk_next(chunk_count);
+
+        for (int step{}; step < m; step++)
+        {
+            hull.emplace_back(groups.hulls[current.group * m + current.vertex]);
+
+            // within its own group, the next vertex is the next clockwise one. other groups are searched chunk by chunk
+            chan_vertex next{ current.group, (current.vertex + 1) % groups.sizes[current.group] };
+            if (chunk_count == 1)
+            {
+                next = chan_next_vertex(groups, current, 0, group_count, next);
+            }
+            else
+            {
+                parallel_for(chunk_count, [&](int begin, int end)
+                {
+                    for (int chunk{ begin }; chunk < end; chunk++)
+                    {
+                        chunk_next[chunk] = chan_next_vertex(groups, current, chunk_begin(group_count, chunk_count, chunk), chunk_begin(group_count, chunk_count, chunk + 1), next);
+                    }
+                });
+                v2 p{ hull.back() };
+                for (chan_vertex candidate : chunk_next)
+                {
+                    if (chan_is_better(groups, p, next, candidate))
+                    {
+                        next = candidate;
+                    }
+                }
+            }
+
+            // compared by value: the first point may have duplicates in other groups
+            if (groups.hulls[next.group * m + next.vertex] == hull.front())
+            {
+                return true;
+            }
+            current = next;
+        }
+
+        hull.clear();
+        return false;
+    }
+
+    // first guess of chan's algorithm: smaller groups cost more in akl_toussaint calls than they save in tangent searches
+    static constexpr int CHAN_FIRST_GROUP_SIZE{ 1 << 8 };
+
+    std::vector<v2> chan(const std::vector<v2>& points)
+    {
+        assert(points.size() >= 3);
+
+        // guess h: m gets squared after every failed round, so that the total work stays O(n log h)
+        chan_groups groups{};
+        std::vector<v2> hull{};
+        for (long long m{ CHAN_FIRST_GROUP_SIZE }; ; m = m * m)
+        {
+            int group_size{ static_cast<int>(std::min(m, static_cast<long long>(points.size()))) };
+            groups = chan_group_hulls(points, group_size, groups.m > 0 ? &groups : nullptr);
+            trace_span span{ "wrap" };
+            if (chan_wrap(groups, hull))
+            {
+                return hull;
+            }
+        }
+    }
+
+    /*
+        Returns the k-th smallest of values[0, count), reordering values. Median of medians selection: the pivot is the
+        median of the medians of groups of five, which guarantees that each step discards a constant fraction of values,
+        so the whole selection is O(count) in the worst case.
+    */
+    static double select_kth(double* values, int count, int k)
+    {
+        assert(0 <= k && k < count);
+
         while (true)
         {
-            assert(hull.size() >= 2);
+            if (count <= 5)
+            {
+                std::sort(values, values + count);
+                return values[k];
+            }
+
+            // medians of groups of five, moved to the front
+            int medians_count{};
+            for (int i{}; i < count; i += 5)
+            {
+                int group_size{ std::min(5, count - i) };
+                std::sort(values + i, values + i + group_size);
+                std::swap(values[medians_count++], values[i + group_size / 2]);
+            }
+            double pivot{ select_kth(values, medians_count, medians_count / 2) };
+
+            // three way partition: [values, less) < pivot, [less, greater) == pivot, [greater, values + count) > pivot
+            double* less{ std::partition(values, values + count, [=](double v) { return v < pivot; }) };
+            double* greater{ std::partition(less, values + count, [=](double v) { return v == pivot; }) };
+            int less_count{ static_cast<int>(less - values) };
+            int greater_begin{ static_cast<int>(greater - values) };
+            if (k < less_count)
+            {
+                count = less_count;
+            }
+            else if (k < greater_begin)
+            {
+                return pivot;
+            }
+            else
+            {
+                values = greater;
+                count -= greater_begin;
+                k -= greater_begin;
+            }
+        }
+    }
+
+    // scratch memory of kirkpatrick seidel, reused across the whole recursion
+    struct kirkpatrick_seidel_scratch
+    {
+        struct point_pair
+        {
+            v2 p; // left point
+            v2 q; // right point
+            double slope;
+        };
+
+        std::vector<v2> candidates{};
+        std::vector<point_pair> pairs{};
+        std::vector<double> values{};
+    };
+
+    /*
+        Upper hull edge (bridge) crossing the vertical line x = a, where points has points on both sides of the line.
+        Prune and search: points are paired up, and the median slope K of the pairs gives a supporting line of the points.
+        Where that line touches the points tells on which side of K the bridge slope is, and then one point out of
+        every pair on the wrong side of K can't be a bridge endpoint. So a quarter of the points go at every step, O(n) overall.
+    */
+    static std::pair<v2, v2> kirkpatrick_seidel_bridge(const std::vector<v2>& points, double a, kirkpatrick_seidel_scratch& scratch)
+    {
+        std::vector<v2>& candidates{ scratch.candidates };
+        auto& pairs{ scratch.pairs };
+        std::vector<double>& slopes{ scratch.values };
+        candidates.assign(points.begin(), points.end());
 
-            bool was_there_any_deletion{ false };
-            int k{};
-            while (0 <= k && k < static_cast<int>(hull.size()))
+        while (candidates.size() > 2)
+        {
+            // pair up candidates. the ones that can't be paired are compacted to the front of candidates
+            pairs.clear();
+            slopes.clear();
+            int unpaired_count{};
+            for (int i{}; i + 1 < static_cast<int>(candidates.size()); i += 2)
             {
-                v2 p{ hull[k] };
-                v2 pn{ hull[(k + 1) % hull.size()] };
-                v2 pnn{ hull[(k + 2) % hull.size()] };
-                double s{ determinant(pnn - pn, pn - p) };
-                if (s >= 0) // convex triplet
+                v2 p{ candidates[i] };
+                v2 q{ candidates[i + 1] };
+                if (q.x < p.x)
                 {
-                    k++;
+                    std::swap(p, q);
                 }
-                else // concave triplet
+
+                if (p.x == q.x)
                 {
-                    hull.erase(hull.begin() + k + 1);
-                    was_there_any_deletion = true;
-                    k--;
+                    candidates[unpaired_count++] = p.y > q.y ? p : q; // the lower one is not on the upper hull
                 }
+                else
+                {
+                    double slope{ (q.y - p.y) / (q.x - p.x) };
+                    pairs.push_back({ p, q, slope });
+                    slopes.emplace_back(slope);
+                }
+            }
+            if (candidates.size() % 2 == 1)
+            {
+                candidates[unpaired_count++] = candidates.back();
+            }
+            candidates.resize(unpaired_count);
+            if (pairs.empty())
+            {
+                continue;
             }
 
-            if (!was_there_any_deletion)
+            double k{ select_kth(slopes.data(), static_cast<int>(slopes.size()), static_cast<int>(slopes.size()) / 2) };
+
+            /*
+                Find the points touched by the supporting line with slope K, i.e. the ones with maximum y - K x.
+                Points are compared with orientation tests along the direction of the median pair, and so are the slopes
+                of the other pairs: the median slope only has to be close to the median for the pruning to be effective,
+                while the tests must be exact (and consistent with each other) for it to be correct.
+            */
+            v2 median_p{};
+            v2 median_q{};
+            for (const auto& pair : pairs)
+            {
+                if (pair.slope == k)
+                {
+                    median_p = pair.p;
+                    median_q = pair.q;
+                    break;
+                }
+            }
+            v2 touched_min{ pairs[0].p }; // leftmost touched point
+            v2 touched_max{ pairs[0].p }; // rightmost touched point
+            auto touch{ [&](v2 c)
+            {
+                double side{ orientation(median_p, median_q, touched_min, c) };
+                if (side > 0)
+                {
+                    touched_min = c;
+                    touched_max = c;
+                }
+                else if (side == 0)
+                {
+                    touched_min = c.x < touched_min.x ? c : touched_min;
+                    touched_max = c.x > touched_max.x ? c : touched_max;
+                }
+            } };
+            for (v2 c : candidates)
             {
-                break;
+                touch(c);
             }
+            for (const auto& pair : pairs)
+            {
+                touch(pair.p);
+                touch(pair.q);
+            }
+
+            if (touched_min.x <= a && a < touched_max.x)
+            {
+                // the supporting line crosses x = a along a hull edge: that's the bridge
+                return { touched_min, touched_max };
+            }
+
+            for (const auto& pair : pairs)
+            {
+                // the slope of the pair compared to K: positive if the median pair turns counterclockwise from the pair
+                double steeper_median{ orientation(pair.p, pair.q, median_p, median_q) };
+                if (touched_max.x <= a)
+                {
+                    // the bridge is to the right, and its slope is smaller than K
+                    if (steeper_median > 0)
+                    {
+                        candidates.emplace_back(pair.p);
+                    }
+                    candidates.emplace_back(pair.q);
+                }
+                else
+                {
+                    // the bridge is to the left, and its slope is greater than K
+                    candidates.emplace_back(pair.p);
+                    if (steeper_median < 0)
+                    {
+                        candidates.emplace_back(pair.q);
+                    }
+                }
+            }
+        }
+
+        assert(candidates.size() == 2);
+        if (candidates[1].x < candidates[0].x)
+        {
+            std::swap(candidates[0], candidates[1]);
+        }
+        return { candidates[0], candidates[1] };
+    }
+
+    /*
+        Appends to hull the upper hull vertices from pmin (included) to pmax (excluded), from left to right.
+        points holds pmin, pmax, and points in between them that lie above the segment pmin -> pmax.
+        Marriage before conquest: the bridge over the median x is found first, and then only the points that can still be
+        on the hull at its two sides are recursed on. Hence O(n log h).
+    */
+    static void kirkpatrick_seidel_upper(const std::vector<v2>& points, v2 pmin, v2 pmax, kirkpatrick_seidel_scratch& scratch, std::vector<v2>& hull)
+    {
+        if (pmin == pmax)
+        {
+            return;
+        }
+        if (points.size() == 2)
+        {
+            hull.emplace_back(pmin);
+            return;
+        }
+
+        // lower median x, so that both sides of x = a have some points
+        std::vector<double>& xs{ scratch.values };
+        xs.clear();
+        for (v2 p : points)
+        {
+            xs.emplace_back(p.x);
+        }
+        double a{ select_kth(xs.data(), static_cast<int>(xs.size()), (static_cast<int>(xs.size()) - 1) / 2) };
+
+        auto [left, right] { kirkpatrick_seidel_bridge(points, a, scratch) };
+
+        // only the points above pmin -> left and above right -> pmax can still be on the upper hull
+        std::vector<v2> left_points{ pmin };
+        std::vector<v2> right_points{ pmax };
+        if (left != pmin)
+        {
+            left_points.emplace_back(left);
+        }
+        if (right != pmax)
+        {
+            right_points.emplace_back(right);
+        }
+        for (v2 p : points)
+        {
+            if (p.x < left.x && orientation(pmin, left, p) > 0)
+            {
+                left_points.emplace_back(p);
+            }
+            else if (p.x > right.x && orientation(right, pmax, p) > 0)
+            {
+                right_points.emplace_back(p);
+            }
+        }
+
+        kirkpatrick_seidel_upper(left_points, pmin, left, scratch, hull);
+        hull.emplace_back(left);
+        kirkpatrick_seidel_upper(right_points, right, pmax, scratch, hull);
+    }
+
+    std::vector<v2> kirkpatrick_seidel(const std::vector<v2>& points)
+    {
+        assert(points.size() >= 3);
+
+        // leftmost and rightmost points (lexicographic, so that they are hull vertices)
+        auto [leftmost, rightmost] { std::minmax_element(points.begin(), points.end(), lexicographic_less<double>) };
+        v2 west{ *leftmost };
+        v2 east{ *rightmost };
+        if (west == east)
+        {
+            return { west }; // all the points are the same
         }
+        if (west.x == east.x)
+        {
+            return { east, west }; // all the points are on a vertical line
+        }
+
+        /*
+            Points can share the leftmost (or rightmost) x: then the upper hull goes between the topmost ones, and the lower
+            hull between the bottommost ones. So no other point of either half has the x of its extremes, and the median x
+            always has points at both sides.
+        */
+        v2 west_top{ west };
+        v2 east_bottom{ east };
+        for (v2 p : points)
+        {
+            if (p.x == west.x && p.y > west_top.y)
+            {
+                west_top = p;
+            }
+            if (p.x == east.x && p.y < east_bottom.y)
+            {
+                east_bottom = p;
+            }
+        }
+        v2 west_bottom{ west };
+        v2 east_top{ east };
 
+        // split points in the ones above and below the two halves. lower points get mirrored (y -> -y), to reuse the upper hull code
+        std::vector<v2> upper_points{ west_top, east_top };
+        std::vector<v2> lower_points{ { west_bottom.x, -west_bottom.y }, { east_bottom.x, -east_bottom.y } };
+        for (v2 p : points)
+        {
+            if (orientation(west_top, east_top, p) > 0)
+            {
+                upper_points.emplace_back(p);
+            }
+            else if (orientation(west_bottom, east_bottom, p) < 0)
+            {
+                lower_points.push_back({ p.x, -p.y });
+            }
+        }
+
+        kirkpatrick_seidel_scratch scratch{};
+        std::vector<v2> hull{};
+        kirkpatrick_seidel_upper(upper_points, west_top, east_top, scratch, hull);
+        hull.emplace_back(east_top);
+        if (east_bottom != east_top)
+        {
+            hull.emplace_back(east_bottom);
+        }
+
+        // clockwise, the lower hull goes from east to west
+        std::vector<v2> lower_hull{};
+        kirkpatrick_seidel_upper(lower_points, lower_points[0], lower_points[1], scratch, lower_hull);
+        for (int i{ static_cast<int>(lower_hull.size()) - 1 }; i > 0; i--)
+        {
+            hull.push_back({ lower_hull[i].x, -lower_hull[i].y });
+        }
+        if (west_bottom != west_top)
+        {
+            hull.emplace_back(west_bottom);
+        }
         return hull;
     }
 
@@ -604,20 +1856,36 @@ namespace ch
         return torch(survivors);
     }
 
-    std::vector<v2> sample_points_for_subset(const std::vector<v2>& points, int k)
+    std::vector<v2> kirkpatrick_seidel_akl_toussaint(const std::vector<v2>& points)
     {
         assert(points.size() >= 3);
+
+        // apply akl toussaint heuristic
+        std::vector<v2> kill_zone{ build_kill_zone(points) };
+        std::vector<v2> survivors{ akl_toussaint_heuristic(points, kill_zone) };
+
+        // run kirkpatrick seidel on survivors
+        return kirkpatrick_seidel(survivors);
+    }
+
+    /*
+        Returns the indices of the sampled points. Points is anything whose operator[] gives back the i-th point as a v2,
+        so that the very same sampling runs on std::vector<v2> and on point_set.
+    */
+    template<typename Points>
+    static std::vector<int> sample_indices_for_subset(const Points& points, int count, int k)
+    {
+        assert(count >= 3);
         assert(k > 0); // we need at least one strip
 
-        // find the two points with minimum and maximum x
-        int min_x_idx{ -1 };
-        int max_x_idx{ -1 };
+        // find the two points with minimum and maximum x (same tie breaking as std::minmax_element)
+        int min_x_idx{ 0 };
+        int max_x_idx{ 0 };
+        for (int i{ 1 }; i < count; i++)
         {
-            auto it{ std::minmax_element(points.begin(), points.end(), [](v2 a, v2 b) { return a.x < b.x; }) };
-            assert(it.first != points.end());
-            assert(it.second != points.end());
-            min_x_idx = static_cast<int>(std::distance(points.begin(), it.first));
-            max_x_idx = static_cast<int>(std::distance(points.begin(), it.second));
+            double x{ points[i].x };
+            min_x_idx = x < points[min_x_idx].x ? i : min_x_idx;
+            max_x_idx = x >= points[max_x_idx].x ? i : max_x_idx;
         }
         assert(min_x_idx >= 0);
         assert(max_x_idx >= 0);
@@ -640,7 +1908,7 @@ namespace ch
         strips.resize(k);
 
         // populate strips
-        for (int i{}; i < static_cast<int>(points.size()); i++)
+        for (int i{}; i < count; i++)
         {
             if (i == min_x_idx || i == max_x_idx)
             {
@@ -672,7 +1940,7 @@ namespace ch
         }
 
         // build new point set from strips
-        std::vector<v2> approximate_points{};
+        std::vector<int> approximate_points{};
         {
             std::unordered_set<int> sampling{}; // set of points indices used for the sampling
             sampling.emplace(min_x_idx); // take the point with min x
@@ -692,13 +1960,30 @@ namespace ch
                 }
             }
 
-            for (int idx : sampling)
-            {
-                approximate_points.emplace_back(points[idx]);
-            }
+            approximate_points.assign(sampling.begin(), sampling.end());
         }
 
         // sampling of initial pointset
         return approximate_points;
     }
+
+    std::vector<v2> sample_points_for_subset(const std::vector<v2>& points, int k)
+    {
+        std::vector<v2> approximate_points{};
+        for (int idx : sample_indices_for_subset(points, static_cast<int>(points.size()), k))
+        {
+            approximate_points.emplace_back(points[idx]);
+        }
+        return approximate_points;
+    }
+
+    point_set sample_points_for_subset(const point_set& points, int k)
+    {
+        point_set approximate_points{};
+        for (int idx : sample_indices_for_subset(points, points.size(), k))
+        {
+            approximate_points.push_back(points[idx]);
+        }
+        return approximate_points;
+    }
 }
@@ -1,12 +1,22 @@
 #pragma once
 
+#include <cstdint>
+#include <span>
 #include <vector>
 
 namespace ch
 {
-    struct v2
+    /*
+        A point (or vector) with coordinates of type T. v2 (double) is the type all the algorithms work with, while a few of
+        them also have overloads for float and int32 coordinates (see below): float points take half the memory bandwidth,
+        and integer points have hulls that are exact with no fallback cost at all.
+        With integer coordinates the arithmetic below may overflow: the algorithms only compare them and feed them to the
+        orientation predicate, which widens them first (see Predicates.h).
+    */
+    template<typename T>
+    struct basic_v2
     {
-        static v2 normal(v2 p)
+        static basic_v2 normal(basic_v2 p)
         {
             /*
                 Given a column vector [a, b] we want to find one column vector [x, y] perpendicular to it.
@@ -19,46 +29,96 @@ namespace ch
             return { -p.y, p.x };
         }
 
-        static double dot(v2 u, v2 v)
+        static T dot(basic_v2 u, basic_v2 v)
         {
             return u.x * v.x + u.y * v.y;
         }
 
-        double x;
-        double y;
+        T x;
+        T y;
 
-        v2(double x, double y) : x{ x }, y{ y } {}
-        v2() : v2{ 0.0, 0.0 } {}
+        basic_v2(T x, T y) : x{ x }, y{ y } {}
+        basic_v2() : basic_v2{ T{}, T{} } {}
 
-        inline v2 operator-(const v2& rhs) const
+        inline basic_v2 operator-(const basic_v2& rhs) const
         {
             return { x - rhs.x, y - rhs.y };
         }
     };
 
+    using v2 = basic_v2<double>;
+    using v2f = basic_v2<float>;
+    using v2i = basic_v2<std::int32_t>;
+
     // returns the determinant of the matrix [u | v]
-    inline double determinant(v2 u, v2 v)
+    template<typename T>
+    inline T determinant(basic_v2<T> u, basic_v2<T> v)
     {
         return u.x * v.y - u.y * v.x;
     }
 
-    inline bool operator==(const v2& lhs, const v2& rhs)
+    template<typename T>
+    inline bool operator==(const basic_v2<T>& lhs, const basic_v2<T>& rhs)
     {
         return lhs.x == rhs.x && lhs.y == rhs.y;
     }
-    inline bool operator!=(const v2& lhs, const v2& rhs)
+    template<typename T>
+    inline bool operator!=(const basic_v2<T>& lhs, const basic_v2<T>& rhs)
     {
         return !(lhs == rhs);
     }
 
+    class point_set; // see PointSet.h
+
+    // the divide and conquer recursion stops at sub-sets of at most base_case_size points, solved by fixed size kernels
+    constexpr int DIVIDE_AND_CONQUER_MAX_BASE_CASE_SIZE{ 8 };
+    constexpr int DIVIDE_AND_CONQUER_BASE_CASE_SIZE{ 4 }; // best value of benchmark_divide_and_conquer_base_case on our machines
+
     std::vector<v2> naive(const std::vector<v2>& points);
     std::vector<v2> divide_and_conquer(const std::vector<v2>& points);
     std::vector<v2> akl_toussaint(const std::vector<v2>& points);
     std::vector<v2> torch(const std::vector<v2>& points);
 
+    // Andrew's monotone chain, as a baseline for the other algorithms
+    std::vector<v2> monotone_chain(const std::vector<v2>& points);
+
+    // quickhull seeded by the akl toussaint kill zone, with the four regions (and large sub-problems) solved in parallel
+    std::vector<v2> quickhull(const std::vector<v2>& points);
+
+    // chan's output sensitive algorithm, O(n log h): group hulls by akl_toussaint (in parallel), then gift wrapping on them
+    std::vector<v2> chan(const std::vector<v2>& points);
+
+    // kirkpatrick-seidel "marriage before conquest", O(n log h): hull edges over median x lines are found by prune and search, without sorting
+    std::vector<v2> kirkpatrick_seidel(const std::vector<v2>& points);
+
+    // same hull as divide_and_conquer, with the two halves of each split computed as parallel tasks
+    std::vector<v2> divide_and_conquer_parallel(const std::vector<v2>& points);
+
+    // divide_and_conquer with a custom base case size, 1 <= base_case_size <= DIVIDE_AND_CONQUER_MAX_BASE_CASE_SIZE
+    std::vector<v2> divide_and_conquer_with_base_case(const std::vector<v2>& points, int base_case_size);
+
     std::vector<v2> naive_akl_toussaint(const std::vector<v2>& points);
     std::vector<v2> divide_and_conquer_akl_toussaint(const std::vector<v2>& points);
     std::vector<v2> torch_akl_toussaint(const std::vector<v2>& points);
+    std::vector<v2> kirkpatrick_seidel_akl_toussaint(const std::vector<v2>& points);
 
     std::vector<v2> sample_points_for_subset(const std::vector<v2>& points, int k);
+
+    // overloads for points stored as a structure of arrays, which read the coordinates in place
+    std::vector<v2> akl_toussaint(const point_set& points);
+    std::vector<v2> torch(const point_set& points);
+    std::vector<v2> divide_and_conquer(const point_set& points);
+    point_set sample_points_for_subset(const point_set& points, int k);
+
+    // overloads for points that are read in place, e.g. straight from a memory mapped point file (see PointIO.h)
+    std::vector<v2> akl_toussaint(std::span<const v2> points);
+    std::vector<v2> akl_toussaint(std::span<const double> xs, std::span<const double> ys);
+
+    // overloads for float and int32 coordinates: same hulls as for the same points as doubles, with twice the points per SIMD register for floats
+    std::vector<v2f> akl_toussaint(const std::vector<v2f>& points);
+    std::vector<v2i> akl_toussaint(const std::vector<v2i>& points);
+    std::vector<v2f> monotone_chain(const std::vector<v2f>& points);
+    std::vector<v2i> monotone_chain(const std::vector<v2i>& points);
+    std::vector<v2f> quickhull(const std::vector<v2f>& points);
+    std::vector<v2i> quickhull(const std::vector<v2i>& points);
 }
@@ -0,0 +1,344 @@
+#include <Dataset.h>
+
+#include <Parallel.h>
+#include <PointIO.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <filesystem>
+#include <numbers>
+#include <random>
+
+namespace ch
+{
+    static bool is_prime(long long n)
+    {
+        if (n < 2) return false;
+        for (long long d{ 2 }; d * d <= n; d++)
+        {
+            if (n % d == 0) return false;
+        }
+        return true;
+    }
+
+    // splitmix64 finalizer, used as a cheap keyed hash
+    static std::uint64_t mix(std::uint64_t z)
+    {
+        z += 0x9e3779b97f4a7c15ull;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+
+    /*
+        Pseudo random permutation of [0, domain), computed independently for each index.
+        It is a four rounds Feistel network over the smallest power of 4 that contains the domain.
+        Values falling outside of the domain are fed back to the network until they fall inside of it (cycle walking).
+    */
+    static long long permute(long long i, long long domain, std::uint64_t seed)
+    {
+        int half_bits{ 1 };
+        while ((1ll << (2 * half_bits)) < domain) half_bits++;
+        std::uint64_t mask{ (1ull << half_bits) - 1 };
+
+        std::uint64_t v{ static_cast<std::uint64_t>(i) };
+        do
+        {
+            std::uint64_t l{ v >> half_bits };
+            std::uint64_t r{ v & mask };
+            for (std::uint64_t round{}; round < 4; round++)
+            {
+                std::uint64_t f{ mix(seed ^ mix(round ^ (r << 2))) & mask };
+                std::uint64_t next_r{ l ^ f };
+                l = r;
+                r = next_r;
+            }
+            v = (l << half_bits) | r;
+        } while (static_cast<long long>(v) >= domain);
+
+        return static_cast<long long>(v);
+    }
+
+    /*
+        Points are taken from the parabola { (t, t^2) : t in Z_p }, moved by a random invertible affine map of Z_p x Z_p.
+        No three points of a conic over Z_p are collinear, and three integer points that are collinear over the integers
+        are collinear over Z_p too. Hence, the determinant of any three of our (integer) points is a non zero integer,
+        i.e. its absolute value is at least 1.0. Scaling the points by s >= 1 scales that determinant by s^2.
+        Both coordinates are quadratic polynomials in t, so any x (or y) value is shared by at most two points of the conic.
+        Conic points are visited in a seeded pseudo random order and a point is kept only if its x and y are still unused.
+        Each kept point discards at most two other points, so out of p >= 4n candidates at least 4n/3 are kept.
+        The whole procedure is O(p) and, apart from the final bookkeeping, embarrassingly parallel.
+    */
+    static std::vector<v2> generate_square(int points_count, std::uint64_t seed)
+    {
+        assert(points_count >= 3);
+
+        long long p{ 4ll * points_count };
+        while (!is_prime(p)) p++;
+
+        // random invertible affine map [x, y] = A [t, t^2] + b
+        std::mt19937_64 generator{ seed };
+        long long a11{}, a12{}, a21{}, a22{};
+        do
+        {
+            a11 = static_cast<long long>(generator() % p);
+            a12 = static_cast<long long>(generator() % p);
+            a21 = static_cast<long long>(generator() % p);
+            a22 = static_cast<long long>(generator() % p);
+        } while (((a11 * a22) % p - (a12 * a21) % p) % p == 0);
+        long long b1{ static_cast<long long>(generator() % p) };
+        long long b2{ static_cast<long long>(generator() % p) };
+        std::uint64_t permutation_seed{ generator() };
+
+        // scale points to [0, 10 * points_count), as before. note that p < 8 * points_count, thus scale > 1.0
+        double scale{ static_cast<double>(points_count) * 10.0 / static_cast<double>(p) };
+
+        std::vector<v2> points{};
+        points.reserve(points_count);
+        std::vector<char> used_x(p), used_y(p);
+        std::vector<long long> candidates{};
+        long long next_candidate{};
+        while (static_cast<int>(points.size()) < points_count)
+        {
+            assert(next_candidate < p); // we always find enough points before running out of candidates
+
+            // map a block of candidates in parallel (as pairs of integer coordinates)
+            long long block_size{ std::min(p - next_candidate, 2ll * (points_count - static_cast<long long>(points.size()))) };
+            candidates.resize(2 * block_size);
+            parallel_for(static_cast<int>(block_size), [&](int begin, int end)
+                {
+                    for (int i{ begin }; i < end; i++)
+                    {
+                        long long t{ permute(next_candidate + i, p, permutation_seed) };
+                        long long t2{ (t * t) % p };
+                        candidates[2 * i + 0] = (a11 * t + a12 * t2 + b1) % p;
+                        candidates[2 * i + 1] = (a21 * t + a22 * t2 + b2) % p;
+                    }
+                });
+            next_candidate += block_size;
+
+            // keep the candidates whose coordinates are still unused (in order, so that the output depends on the seed only)
+            for (long long i{}; i < block_size && static_cast<int>(points.size()) < points_count; i++)
+            {
+                long long x{ candidates[2 * i + 0] };
+                long long y{ candidates[2 * i + 1] };
+                if (!used_x[x] && !used_y[y])
+                {
+                    used_x[x] = 1;
+                    used_y[y] = 1;
+                    points.emplace_back(static_cast<double>(x) * scale, static_cast<double>(y) * scale);
+                }
+            }
+        }
+
+        return points;
+    }
+    // uniform in [0, 1), out of 53 random bits
+    static double uniform01(std::uint64_t bits)
+    {
+        return static_cast<double>(bits >> 11) * 0x1.0p-53;
+    }
+
+    /*
+        Counter based random numbers: the k-th random number of the i-th point.
+        Points never share a generator state, thus they can be generated in any order (and in parallel).
+    */
+    static std::uint64_t random_bits(std::uint64_t seed, long long i, int k)
+    {
+        return mix(seed ^ mix(static_cast<std::uint64_t>(i) * 4 + static_cast<std::uint64_t>(k)));
+    }
+
+    // standard normal, by means of the Box-Muller transform
+    static v2 standard_normal(std::uint64_t seed, long long i)
+    {
+        double u1{ 1.0 - uniform01(random_bits(seed, i, 0)) }; // (0, 1], since we take its logarithm
+        double u2{ uniform01(random_bits(seed, i, 1)) };
+        double r{ std::sqrt(-2.0 * std::log(u1)) };
+        double theta{ 2.0 * std::numbers::pi * u2 };
+        return { r * std::cos(theta), r * std::sin(theta) };
+    }
+
+    static std::vector<v2> generate_independent(distribution d, int count, std::uint64_t seed)
+    {
+        double side{ static_cast<double>(count) * 10.0 };
+        v2 center{ side / 2.0, side / 2.0 };
+        double radius{ side / 2.0 };
+
+        // clusters centers and spread
+        int clusters_count{ std::max(1, static_cast<int>(std::sqrt(static_cast<double>(count))) / 10) };
+        std::vector<v2> clusters{};
+        for (int j{}; j < clusters_count; j++)
+        {
+            std::uint64_t cluster_seed{ mix(seed ^ 0xc105735eedull) };
+            double x{ 0.1 + 0.8 * uniform01(random_bits(cluster_seed, j, 0)) };
+            double y{ 0.1 + 0.8 * uniform01(random_bits(cluster_seed, j, 1)) };
+            clusters.emplace_back(x * side, y * side);
+        }
+        double cluster_sigma{ side * 0.02 };
+
+        // grid cells
+        long long grid_side{ static_cast<long long>(std::ceil(std::sqrt(static_cast<double>(count)))) };
+        double cell_side{ side / static_cast<double>(grid_side) };
+
+        // lattice nodes: about 16 points per node
+        long long lattice_side{ std::max(2ll, grid_side / 4) };
+        double lattice_step{ side / static_cast<double>(lattice_side) };
+
+        std::vector<v2> points(count);
+        parallel_for(count, [&](int begin, int end)
+            {
+                for (int i{ begin }; i < end; i++)
+                {
+                    double u1{ uniform01(random_bits(seed, i, 2)) };
+                    double u2{ uniform01(random_bits(seed, i, 3)) };
+                    v2 p{};
+                    switch (d)
+                    {
+                    case distribution::disk:
+                    {
+                        double r{ radius * std::sqrt(u1) };
+                        double theta{ 2.0 * std::numbers::pi * u2 };
+                        p = { center.x + r * std::cos(theta), center.y + r * std::sin(theta) };
+                    } break;
+                    case distribution::gaussian:
+                    {
+                        v2 n{ standard_normal(seed, i) };
+                        p = { center.x + n.x * radius / 5.0, center.y + n.y * radius / 5.0 };
+                    } break;
+                    case distribution::circle:
+                    {
+                        double theta{ 2.0 * std::numbers::pi * u1 };
+                        p = { center.x + radius * std::cos(theta), center.y + radius * std::sin(theta) };
+                    } break;
+                    case distribution::near_circle:
+                    {
+                        double r{ radius * (1.0 - 0.01 * u2) };
+                        double theta{ 2.0 * std::numbers::pi * u1 };
+                        p = { center.x + r * std::cos(theta), center.y + r * std::sin(theta) };
+                    } break;
+                    case distribution::clustered:
+                    {
+                        v2 c{ clusters[random_bits(seed, i, 2) % clusters_count] };
+                        v2 n{ standard_normal(seed, i) };
+                        p = { c.x + n.x * cluster_sigma, c.y + n.y * cluster_sigma };
+                    } break;
+                    case distribution::grid:
+                    {
+                        // distinct cells for distinct points
+                        long long cell{ permute(i, grid_side * grid_side, seed) };
+                        double cell_x{ static_cast<double>(cell % grid_side) };
+                        double cell_y{ static_cast<double>(cell / grid_side) };
+                        p = { (cell_x + 0.1 + 0.8 * u1) * cell_side, (cell_y + 0.1 + 0.8 * u2) * cell_side };
+                    } break;
+                    case distribution::lattice:
+                    {
+                        double node_x{ std::floor(u1 * static_cast<double>(lattice_side)) };
+                        double node_y{ std::floor(u2 * static_cast<double>(lattice_side)) };
+                        p = { node_x * lattice_step, node_y * lattice_step };
+                    } break;
+                    default:
+                    {
+                        assert(false);
+                    } break;
+                    }
+                    points[i] = p;
+                }
+            });
+        return points;
+    }
+
+    const char* distribution_name(distribution d)
+    {
+        switch (d)
+        {
+        case distribution::square: return "square";
+        case distribution::disk: return "disk";
+        case distribution::gaussian: return "gaussian";
+        case distribution::circle: return "circle";
+        case distribution::near_circle: return "near_circle";
+        case distribution::clustered: return "clustered";
+        case distribution::grid: return "grid";
+        case distribution::lattice: return "lattice";
+        }
+        assert(false);
+        return "";
+    }
+
+    bool parse_distribution(const std::string& name, distribution& d)
+    {
+        for (distribution candidate : ALL_DISTRIBUTIONS)
+        {
+            if (name == distribution_name(candidate))
+            {
+                d = candidate;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::vector<v2> generate_points(distribution d, int count, std::uint64_t seed)
+    {
+        assert(count >= 3);
+
+        if (d == distribution::square)
+        {
+            return generate_square(count, seed);
+        }
+        else
+        {
+            return generate_independent(d, count, seed);
+        }
+    }
+
+    // the cache files are binary point files (see PointIO.h), f64 and aos, so that the points are copied straight out of the mapping
+    static bool read_cached_points(const std::filesystem::path& path, int count, std::vector<v2>& points)
+    {
+        mapped_point_file file{ path.string() };
+        if (!file.is_open() || file.type() != coordinate_type::f64 || file.layout() != point_layout::aos || file.size() != count)
+        {
+            return false;
+        }
+
+        std::span<const v2> cached{ file.points() };
+        points.assign(cached.begin(), cached.end());
+        return true;
+    }
+
+    static void write_cached_points(const std::filesystem::path& path, const std::vector<v2>& points)
+    {
+        // write to a temporary file first, so that concurrent runs never see a partially written dataset
+        std::filesystem::path tmp_path{ path };
+        tmp_path += ".tmp";
+        if (!write_binary_points(tmp_path.string(), points))
+        {
+            return; // caching is best effort
+        }
+        std::error_code error{};
+        std::filesystem::rename(tmp_path, path, error);
+    }
+
+    std::vector<v2> load_or_generate_points(distribution d, int count, std::uint64_t seed, const std::string& cache_dir, bool* cache_hit)
+    {
+        std::filesystem::path path{ cache_dir };
+        path /= std::string{ distribution_name(d) } + "_" + std::to_string(count) + "_" + std::to_string(seed) + ".bin";
+
+        std::vector<v2> points{};
+        bool hit{ read_cached_points(path, count, points) };
+        if (!hit)
+        {
+            points = generate_points(d, count, seed);
+
+            std::error_code error{};
+            std::filesystem::create_directories(cache_dir, error);
+            write_cached_points(path, points);
+        }
+
+        if (cache_hit)
+        {
+            *cache_hit = hit;
+        }
+        return points;
+    }
+}
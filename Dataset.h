@@ -0,0 +1,59 @@
+#pragma once
+
+#include <ConvexHull.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ch
+{
+    enum class distribution
+    {
+        square,      // uniform in a square, with no two points sharing (close) x or y and no three (nearly) collinear points
+        disk,        // uniform in a disk
+        gaussian,    // normal around the center of the square, with a standard deviation of a tenth of its side
+        circle,      // on a circle, thus every point is a hull point (h = n)
+        near_circle, // in a thin annulus, thus most points are hull points (h ~ n)
+        clustered,   // normal around about sqrt(count) / 10 random centers, with a standard deviation of a fiftieth of the side
+        grid,        // one point for each cell of a grid, jittered inside of the cell
+        lattice,     // on a coarse integer lattice, thus with many duplicate and collinear points (also on the hull)
+    };
+
+    constexpr distribution ALL_DISTRIBUTIONS[]
+    {
+        distribution::square,
+        distribution::disk,
+        distribution::gaussian,
+        distribution::circle,
+        distribution::near_circle,
+        distribution::clustered,
+        distribution::grid,
+        distribution::lattice,
+    };
+
+    const char* distribution_name(distribution d);
+    bool parse_distribution(const std::string& name, distribution& d);
+
+    /*
+        Generates count points following the given distribution, in a square of side 10 * count: [0, 10 * count)^2.
+        gaussian and clustered points are not bounded by the square, though: they stray out of it by up to about 0.36 and
+        0.07 of its side respectively (Box-Muller normals reach about 8.6 standard deviations).
+        The output only depends on (d, count, seed), across runs on the same platform. square, grid and lattice points are
+        the same on every platform too, while disk, gaussian, circle, near_circle and clustered go through std::log,
+        std::sin and std::cos, which are not correctly rounded: their last bits may differ across standard libraries.
+        A prefix of k points is not the dataset of k points: the square, and thus every point, scales with count, and so
+        do the number of clustered centers and the grid and lattice spacing. For all but square and grid, which pick their
+        points out of a count dependent set (conic points, grid cells), points are generated independently of each other,
+        so that a prefix is still a sample of the distribution of the whole dataset.
+    */
+    std::vector<v2> generate_points(distribution d, int count, std::uint64_t seed);
+
+    /*
+        Same as generate_points, but datasets are cached on disk inside cache_dir, keyed by (d, count, seed).
+        The key doesn't tell platforms apart (see generate_points): don't share a cache between them.
+        If the dataset is already in the cache, it is loaded instead of being generated.
+        cache_hit (if not null) tells whether the dataset came from the cache.
+    */
+    std::vector<v2> load_or_generate_points(distribution d, int count, std::uint64_t seed, const std::string& cache_dir = "datasets", bool* cache_hit = nullptr);
+}
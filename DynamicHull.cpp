@@ -0,0 +1,402 @@
+#include <DynamicHull.h>
+
+#include <Predicates.h>
+
+#include <algorithm>
+#include <cassert>
+
+namespace ch
+{
+    // a subtree is rebuilt as soon as one of its children has more than this fraction of its leaves
+    static constexpr double DYNAMIC_HULL_BALANCE{ 0.75 };
+
+    // order of the leaves: by x, then by y
+    static bool less(v2 a, v2 b)
+    {
+        return a.x < b.x || (a.x == b.x && a.y < b.y);
+    }
+
+    // the lower hull is the upper hull of the points mirrored along the x axis
+    static v2 view(v2 p, int side)
+    {
+        return side == 0 ? p : v2{ p.x, -p.y };
+    }
+
+    // whether the lines through a1, a2 and through b1, b2 meet before separator, in the order of the leaves
+    static bool meets_before(v2 a1, v2 a2, v2 b1, v2 b2, v2 separator)
+    {
+        double side_x{ intersection_side(a1, a2, b1, b2, separator.x) };
+        if (side_x != 0)
+        {
+            return side_x < 0;
+        }
+        // same x: compare the y, by swapping the coordinates of everything
+        auto swap{ [](v2 p) { return v2{ p.y, p.x }; } };
+        return intersection_side(swap(a1), swap(a2), swap(b1), swap(b2), separator.y) < 0;
+    }
+
+    int dynamic_hull::new_node(const node& n)
+    {
+        if (m_free.empty())
+        {
+            m_nodes.emplace_back(n);
+            return static_cast<int>(m_nodes.size()) - 1;
+        }
+        int idx{ m_free.back() };
+        m_free.pop_back();
+        m_nodes[idx] = n;
+        return idx;
+    }
+
+    void dynamic_hull::free_subtree(int n)
+    {
+        if (!is_leaf(n))
+        {
+            free_subtree(m_nodes[n].left);
+            free_subtree(m_nodes[n].right);
+        }
+        m_free.emplace_back(n);
+    }
+
+    /*
+        Recomputes size and bridges of inner node n from its children, by descending both children at the same time
+        (Overmars and van Leeuwen). At every step the bridge between the hulls of a and b is the bridge we are looking
+        for, and at least one of them moves one level down. With a1 -> a2 the bridge of a and b1 -> b2 the one of b:
+        - if b1 lies above (or on) the line through a1 and a2, the left endpoint is at the left of a2
+        - if a2 lies above (or on) the line through b1 and b2, the right endpoint is at the right of b1
+        - otherwise the two lines meet between a2 and b1: if they meet at the left of the line separating the two
+          children, the left endpoint is at the right of a1, else the right endpoint is at the left of b2
+        A leaf can be seen as a bridge whose endpoints coincide.
+        Points sharing the same x are handled as if the plane were sheared by an infinitesimal amount, so that x grows
+        with y: this is the order of the leaves, it doesn't change orientations, and "at the left of the separator"
+        becomes a lexicographic comparison of the meeting point with the greatest point of the left child.
+    */
+    void dynamic_hull::update(int n)
+    {
+        node& current{ m_nodes[n] };
+        current.size = m_nodes[current.left].size + m_nodes[current.right].size;
+
+        v2 separator{ current.point };
+        for (int side{ UPPER }; side <= LOWER; side++)
+        {
+            int a{ current.left };
+            int b{ current.right };
+            while (!is_leaf(a) || !is_leaf(b))
+            {
+                v2 a1{ view(is_leaf(a) ? m_nodes[a].point : m_nodes[a].bridge_from[side], side) };
+                v2 a2{ view(is_leaf(a) ? m_nodes[a].point : m_nodes[a].bridge_to[side], side) };
+                v2 b1{ view(is_leaf(b) ? m_nodes[b].point : m_nodes[b].bridge_from[side], side) };
+                v2 b2{ view(is_leaf(b) ? m_nodes[b].point : m_nodes[b].bridge_to[side], side) };
+
+                // a collinear b1 (or a2) means that a2 (or b1) lies between the other two and is not a vertex
+                bool a_goes_left{ !is_leaf(a) && orientation(a1, a2, b1) >= 0 };
+                bool b_goes_right{ !is_leaf(b) && orientation(b1, b2, a2) >= 0 };
+                if (a_goes_left || b_goes_right)
+                {
+                    if (a_goes_left)
+                    {
+                        a = m_nodes[a].left;
+                    }
+                    if (b_goes_right)
+                    {
+                        b = m_nodes[b].right;
+                    }
+                }
+                else if (is_leaf(a))
+                {
+                    b = m_nodes[b].left;
+                }
+                else if (is_leaf(b))
+                {
+                    a = m_nodes[a].right;
+                }
+                else
+                {
+                    // the separator is in the original coordinates: so are the points, as view is its own inverse
+                    if (meets_before(view(a1, side), view(a2, side), view(b1, side), view(b2, side), separator))
+                    {
+                        a = m_nodes[a].right;
+                    }
+                    else
+                    {
+                        b = m_nodes[b].left;
+                    }
+                }
+            }
+            current.bridge_from[side] = m_nodes[a].point;
+            current.bridge_to[side] = m_nodes[b].point;
+        }
+    }
+
+    // p is in the subtree of inner node n: keeps only the flags of the hulls of n that still have p as a vertex
+    void dynamic_hull::keep_on_hull(int n, v2 p, bool on_hull[2]) const
+    {
+        const node& current{ m_nodes[n] };
+        bool in_left{ !less(current.point, p) };
+        for (int side{ UPPER }; side <= LOWER; side++)
+        {
+            on_hull[side] = on_hull[side] && (in_left ? !less(current.bridge_from[side], p) : !less(p, current.bridge_to[side]));
+        }
+    }
+
+    // builds a perfectly balanced subtree over the sorted points[begin, end) and returns its root
+    int dynamic_hull::build(const std::vector<v2>& points, int begin, int end)
+    {
+        assert(begin < end);
+
+        if (end - begin == 1)
+        {
+            return new_node({ points[begin] });
+        }
+
+        int middle{ begin + (end - begin) / 2 };
+        int left{ build(points, begin, middle) };
+        int right{ build(points, middle, end) };
+        int n{ new_node({ points[middle - 1], left, right }) };
+        update(n);
+        return n;
+    }
+
+    void dynamic_hull::collect(int n, std::vector<v2>& points) const
+    {
+        if (is_leaf(n))
+        {
+            points.emplace_back(m_nodes[n].point);
+        }
+        else
+        {
+            collect(m_nodes[n].left, points);
+            collect(m_nodes[n].right, points);
+        }
+    }
+
+    int dynamic_hull::rebuild(int n)
+    {
+        std::vector<v2> points{};
+        points.reserve(m_nodes[n].size);
+        collect(n, points);
+        free_subtree(n);
+        return build(points, 0, static_cast<int>(points.size()));
+    }
+
+    bool dynamic_hull::insert(v2 p)
+    {
+        if (m_root == -1)
+        {
+            m_root = new_node({ p });
+            m_max_size = 1;
+            return true;
+        }
+
+        // find the leaf p would be next to
+        std::vector<int> path{};
+        int n{ m_root };
+        while (!is_leaf(n))
+        {
+            path.emplace_back(n);
+            n = less(m_nodes[n].point, p) ? m_nodes[n].right : m_nodes[n].left;
+        }
+        v2 leaf_point{ m_nodes[n].point };
+        if (leaf_point == p)
+        {
+            return false;
+        }
+
+        // the leaf becomes an inner node with two leaves: the old point and p
+        int old_leaf{ new_node({ leaf_point }) };
+        int new_leaf{ new_node({ p }) };
+        if (less(p, leaf_point))
+        {
+            m_nodes[n] = { p, new_leaf, old_leaf };
+        }
+        else
+        {
+            m_nodes[n] = { leaf_point, old_leaf, new_leaf };
+        }
+        path.emplace_back(n);
+        for (int i{ static_cast<int>(path.size()) - 1 }; i >= 0; i--)
+        {
+            m_nodes[path[i]].size++;
+        }
+
+        // rebuild the highest unbalanced subtree on the path, if any. Its bridges are then fresh, the ones above it are not
+        int fresh{ static_cast<int>(path.size()) };
+        for (int i{}; i < fresh; i++)
+        {
+            const node& current{ m_nodes[path[i]] };
+            int largest_child{ std::max(m_nodes[current.left].size, m_nodes[current.right].size) };
+            if (current.size > 2 && largest_child > DYNAMIC_HULL_BALANCE * current.size)
+            {
+                int rebuilt{ rebuild(path[i]) };
+                if (i == 0)
+                {
+                    m_root = rebuilt;
+                }
+                else
+                {
+                    node& parent{ m_nodes[path[i - 1]] };
+                    (parent.left == path[i] ? parent.left : parent.right) = rebuilt;
+                }
+                fresh = i;
+            }
+        }
+        if (fresh < static_cast<int>(path.size()))
+        {
+            for (int i{ fresh - 1 }; i >= 0; i--)
+            {
+                update(path[i]);
+            }
+        }
+        else
+        {
+            // the hulls stop changing above the first node whose hulls don't have p as a vertex
+            bool on_hull[2]{ true, true };
+            for (int i{ static_cast<int>(path.size()) - 1 }; i >= 0 && (on_hull[UPPER] || on_hull[LOWER]); i--)
+            {
+                update(path[i]);
+                keep_on_hull(path[i], p, on_hull);
+            }
+        }
+
+        m_max_size = std::max(m_max_size, size());
+        return true;
+    }
+
+    bool dynamic_hull::erase(v2 p)
+    {
+        if (m_root == -1)
+        {
+            return false;
+        }
+
+        std::vector<int> path{};
+        int n{ m_root };
+        while (!is_leaf(n))
+        {
+            path.emplace_back(n);
+            n = less(m_nodes[n].point, p) ? m_nodes[n].right : m_nodes[n].left;
+        }
+        if (m_nodes[n].point != p)
+        {
+            return false;
+        }
+
+        if (path.empty())
+        {
+            // p was the only point
+            m_free.emplace_back(n);
+            m_root = -1;
+            m_max_size = 0;
+            return true;
+        }
+
+        // only the nodes below the first one whose hulls don't have p as a vertex need new bridges
+        int stale{ static_cast<int>(path.size()) };
+        bool on_hull[2]{ true, true };
+        for (int i{ static_cast<int>(path.size()) - 1 }; i >= 0 && (on_hull[UPPER] || on_hull[LOWER]); i--)
+        {
+            stale = i;
+            keep_on_hull(path[i], p, on_hull);
+        }
+        for (int i{ static_cast<int>(path.size()) - 1 }; i >= 0; i--)
+        {
+            m_nodes[path[i]].size--;
+        }
+
+        // the parent of the leaf is replaced by the sibling of the leaf
+        int parent{ path.back() };
+        path.pop_back();
+        int sibling{ m_nodes[parent].left == n ? m_nodes[parent].right : m_nodes[parent].left };
+        if (path.empty())
+        {
+            m_root = sibling;
+        }
+        else
+        {
+            node& grandparent{ m_nodes[path.back()] };
+            (grandparent.left == parent ? grandparent.left : grandparent.right) = sibling;
+        }
+        m_free.emplace_back(n);
+        m_free.emplace_back(parent);
+
+        // after many deletions the whole tree is rebuilt, so that its height stays logarithmic in the current size
+        if (size() < DYNAMIC_HULL_BALANCE * m_max_size)
+        {
+            m_root = rebuild(m_root);
+            m_max_size = size();
+            return true;
+        }
+
+        for (int i{ static_cast<int>(path.size()) - 1 }; i >= stale; i--)
+        {
+            update(path[i]);
+        }
+        return true;
+    }
+
+    /*
+        Appends to out the vertices of the upper hull (in the given side view) of subtree n, that are between lo and hi
+        (both included), from left to right. Only the part of the hull of each child up to the bridge is visited.
+    */
+    void dynamic_hull::report(int n, int side, v2 lo, v2 hi, std::vector<v2>& out) const
+    {
+        const node& current{ m_nodes[n] };
+        if (is_leaf(n))
+        {
+            if (!less(current.point, lo) && !less(hi, current.point))
+            {
+                out.emplace_back(current.point);
+            }
+            return;
+        }
+
+        v2 from{ current.bridge_from[side] };
+        v2 to{ current.bridge_to[side] };
+        if (!less(from, lo))
+        {
+            report(current.left, side, lo, less(hi, from) ? hi : from, out);
+        }
+        if (!less(hi, to))
+        {
+            report(current.right, side, less(to, lo) ? lo : to, hi, out);
+        }
+    }
+
+    std::vector<v2> dynamic_hull::hull() const
+    {
+        std::vector<v2> hull{};
+        if (m_root == -1)
+        {
+            return hull;
+        }
+
+        v2 lo{ m_nodes[m_root].point };
+        v2 hi{ m_nodes[m_root].point };
+        {
+            int n{ m_root };
+            while (!is_leaf(n))
+            {
+                n = m_nodes[n].left;
+            }
+            lo = m_nodes[n].point;
+            n = m_root;
+            while (!is_leaf(n))
+            {
+                n = m_nodes[n].right;
+            }
+            hi = m_nodes[n].point;
+        }
+
+        // upper hull from left to right
+        report(m_root, UPPER, lo, hi, hull);
+
+        // lower hull from right to left, without the two extremes shared with the upper hull
+        std::vector<v2> lower{};
+        report(m_root, LOWER, lo, hi, lower);
+        for (int i{ static_cast<int>(lower.size()) - 2 }; i > 0; i--)
+        {
+            hull.emplace_back(lower[i]);
+        }
+        return hull;
+    }
+}
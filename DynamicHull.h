@@ -0,0 +1,60 @@
+#pragma once
+
+#include <ConvexHull.h>
+
+#include <vector>
+
+namespace ch
+{
+    /*
+        Convex hull of a set of points that supports both insertions and deletions, in polylogarithmic time.
+        Points are the leaves of a balanced binary search tree sorted by x. Every inner node stores the bridges (i.e. the
+        edges joining the hulls of its two subtrees) of the upper and of the lower hull: the hull of a subtree is then
+        implicitly given by the hulls of its children, cut at the bridge.
+        A bridge is found in O(log n) by descending the two subtrees at the same time, so an update costs O(log^2 n).
+        The tree is kept balanced by rebuilding its too unbalanced subtrees (scapegoat tree).
+        Duplicate, collinear and same x points are fine: the hull only has its strict vertices.
+    */
+    class dynamic_hull
+    {
+    public:
+        dynamic_hull() = default;
+    public:
+        // returns false if p is already in the set
+        bool insert(v2 p);
+        // returns false if p is not in the set
+        bool erase(v2 p);
+        // clockwise hull, starting from the leftmost point. O(h log n)
+        std::vector<v2> hull() const;
+        int size() const { return m_root == -1 ? 0 : m_nodes[m_root].size; }
+        bool empty() const { return m_root == -1; }
+    private:
+        static constexpr int UPPER{ 0 };
+        static constexpr int LOWER{ 1 };
+
+        struct node
+        {
+            v2 point{};       // leaf: the point. inner node: greatest point of the left subtree (used to route searches)
+            int left{ -1 };   // -1 for leaves
+            int right{ -1 };  // -1 for leaves
+            int size{ 1 };    // number of leaves
+            v2 bridge_from[2]{ {}, {} }; // inner node: left endpoint of the bridge, for the upper and for the lower hull
+            v2 bridge_to[2]{ {}, {} };   // inner node: right endpoint of the bridge, for the upper and for the lower hull
+        };
+    private:
+        bool is_leaf(int n) const { return m_nodes[n].left == -1; }
+        int new_node(const node& n);
+        void free_subtree(int n);
+        void update(int n);
+        void keep_on_hull(int n, v2 p, bool on_hull[2]) const;
+        int build(const std::vector<v2>& points, int begin, int end);
+        int rebuild(int n);
+        void collect(int n, std::vector<v2>& points) const;
+        void report(int n, int side, v2 lo, v2 hi, std::vector<v2>& out) const;
+    private:
+        std::vector<node> m_nodes; // node pool, nodes are referred to by index
+        std::vector<int> m_free;   // free slots of the pool
+        int m_root{ -1 };
+        int m_max_size{};          // max size reached since the last full rebuild
+    };
+}
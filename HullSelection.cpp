@@ -0,0 +1,109 @@
+#include <HullSelection.h>
+
+#include <Predicates.h>
+#include <ScratchHull.h>
+#include <Trace.h>
+
+#include <algorithm>
+#include <cassert>
+
+namespace ch
+{
+    const char* hull_engine_name(hull_engine engine)
+    {
+        switch (engine)
+        {
+        case hull_engine::monotone_chain: return "monotone_chain";
+        case hull_engine::torch: return "torch";
+        case hull_engine::quickhull: return "quickhull";
+        }
+        assert(false);
+        return "";
+    }
+
+    // strided sample of the probes of the calling thread, which only ever grows
+    static thread_local std::vector<v2> t_sample{};
+
+    /*
+        Whether at least min_hull_count points of a strided sample of points lie on the hull of the sample. Strided, rather
+        than random or a prefix, so that inputs that come sorted (e.g. by x) are still sampled across their whole extent.
+    */
+    static bool sample_in_convex_position(const std::vector<v2>& points, int sample_count, double min_hull_count)
+    {
+        assert(sample_count >= 3);
+
+        trace_span span{ "probe" };
+
+        std::vector<v2>& sample{ t_sample };
+        if (static_cast<int>(sample.size()) < sample_count)
+        {
+            sample.resize(sample_count);
+        }
+
+        long long count{ static_cast<long long>(points.size()) };
+        v2 left{ points[0] }, top{ points[0] }, right{ points[0] }, bottom{ points[0] };
+        for (int i{}; i < sample_count; i++)
+        {
+            v2 p{ points[i * count / sample_count] };
+            sample[i] = p;
+            left = p.x < left.x ? p : left;
+            top = p.y > top.y ? p : top;
+            right = p.x > right.x ? p : right;
+            bottom = p.y < bottom.y ? p : bottom;
+        }
+
+        /*
+            Hull vertices of the sample are either its extremes or survivors of its kill zone (i.e. they lie outside of
+            the quadrilateral of the extremes). Far from convex position most of the sample falls within the kill zone, and
+            the survivors alone rule it out in linear time, without sorting: as soon as so many points are killed that the
+            rest could not make up min_hull_count anymore.
+        */
+        double max_killed{ sample_count + 4 - min_hull_count };
+        int killed_count{};
+        for (int i{}; i < sample_count; i++)
+        {
+            v2 p{ sample[i] };
+            bool killed{ orientation(left, top, p) <= 0 && orientation(top, right, p) <= 0 && orientation(right, bottom, p) <= 0 && orientation(bottom, left, p) <= 0 };
+            killed_count += killed ? 1 : 0;
+            if (killed_count > max_killed)
+            {
+                return false;
+            }
+        }
+
+        // otherwise the hull is counted (a call to monotone_chain would cost more in allocations alone)
+        int hull_size{ scratch_hull(sample.data(), sample_count, nullptr) };
+        return hull_size >= min_hull_count;
+    }
+
+    hull_engine select_hull_engine(const std::vector<v2>& points, const hull_selection_table& table)
+    {
+        assert(table.probe_min_sample >= 3 && table.probe_min_sample <= table.probe_min_count && table.probe_min_sample <= table.probe_max_sample);
+
+        int count{ static_cast<int>(points.size()) };
+        if (count < table.probe_min_count)
+        {
+            return hull_engine::monotone_chain;
+        }
+
+        int sample_count{ std::clamp(count / table.probe_sample_divisor, table.probe_min_sample, std::min(table.probe_max_sample, count)) };
+        double min_hull_count{ std::min(table.convex_position_fraction * sample_count, static_cast<double>(sample_count - table.convex_interior_slack)) };
+        if (sample_in_convex_position(points, sample_count, min_hull_count))
+        {
+            return count < table.convex_torch_min_count ? hull_engine::monotone_chain : hull_engine::torch;
+        }
+        return count < table.quickhull_min_count ? hull_engine::torch : hull_engine::quickhull;
+    }
+
+    std::vector<v2> convex_hull(const std::vector<v2>& points, const hull_selection_table& table)
+    {
+        switch (select_hull_engine(points, table))
+        {
+        case hull_engine::monotone_chain: return monotone_chain(points);
+        case hull_engine::torch: return torch(points);
+        case hull_engine::quickhull: return quickhull(points);
+        }
+        assert(false);
+        return {};
+    }
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <ConvexHull.h>
+
+#include <vector>
+
+namespace ch
+{
+    /*
+        Automatic algorithm selection: convex_hull probes the points cheaply and then hands them to the engine that is
+        fastest for inputs like them.
+        The probe is the hull of a small strided sample: the fraction of the sample that lies on its hull tells inputs in
+        (nearly) convex position, e.g. points on a circle, on which quickhull can discard almost nothing, apart
+        from everything else, on which quickhull (seeded by the akl toussaint kill zone) is the fastest from about a hundred
+        points on. Most inputs are told apart by the kill zone survivors of the sample alone, without sorting it. Very
+        small inputs skip the probe altogether.
+        The sample grows with the input: a thin ring (e.g. near_circle) is in convex position to a coarse sample, which is
+        right for as long as the ring is small enough for monotone_chain to win on it, and stops being so about where
+        quickhull starts to win.
+    */
+
+    enum class hull_engine
+    {
+        monotone_chain,
+        torch,
+        quickhull,
+    };
+
+    const char* hull_engine_name(hull_engine engine);
+
+    /*
+        Thresholds of the selection, calibrated with "ConvexHull benchmark" on all of the distributions of Dataset.h.
+        Re-run the benchmark (e.g. --n 16:1000000:x2) and move them where the engines cross over on your machine.
+    */
+    struct hull_selection_table
+    {
+        int probe_min_count{ 128 };             // below this many points there is no probe: monotone_chain
+        int probe_sample_divisor{ 20 };         // the probe samples one point every that many...
+        int probe_min_sample{ 12 };             // ... but at least this many points...
+        int probe_max_sample{ 64 };             // ... and at most this many: the sample is sorted, at about 50 ns per point
+        double convex_position_fraction{ 0.9 }; // sample hull fraction from which the points are taken as in convex position
+        int convex_interior_slack{ 2 };         // ... or all but this many sample points, if fewer: small samples of thin rings have a couple inside
+        int convex_torch_min_count{ 768 };      // points in convex position: monotone_chain below, torch from here
+        int quickhull_min_count{ 128 };         // other points: torch below, quickhull from here
+    };
+
+    constexpr hull_selection_table DEFAULT_HULL_SELECTION_TABLE{};
+
+    // the engine convex_hull would run on points
+    hull_engine select_hull_engine(const std::vector<v2>& points, const hull_selection_table& table = DEFAULT_HULL_SELECTION_TABLE);
+
+    // hull of points (same preconditions and output as the other algorithms) by the engine chosen by select_hull_engine
+    std::vector<v2> convex_hull(const std::vector<v2>& points, const hull_selection_table& table = DEFAULT_HULL_SELECTION_TABLE);
+}
@@ -0,0 +1,117 @@
+#include <HullStats.h>
+
+#include <mutex>
+#include <vector>
+
+namespace ch
+{
+    namespace
+    {
+        constexpr int COUNTER_COUNT{ static_cast<int>(hull_counter::count) };
+
+        /*
+            Per thread counters. A thread takes a block on its first count and gives it back when it exits: its counts are
+            then moved to the retired ones, and the block can be taken by another thread.
+            The registry is never destroyed, since the pool threads may exit after the static objects are gone.
+        */
+        class hull_stats_registry
+        {
+        public:
+            static hull_stats_registry& instance()
+            {
+                static hull_stats_registry* registry{ new hull_stats_registry{} };
+                return *registry;
+            }
+        public:
+            hull_thread_stats* acquire()
+            {
+                std::lock_guard<std::mutex> lock{ m_mutex };
+                if (!m_free.empty())
+                {
+                    hull_thread_stats* stats{ m_free.back() };
+                    m_free.pop_back();
+                    return stats;
+                }
+                m_blocks.emplace_back(new hull_thread_stats{});
+                return m_blocks.back();
+            }
+            void release(hull_thread_stats* stats)
+            {
+                std::lock_guard<std::mutex> lock{ m_mutex };
+                for (int i{}; i < COUNTER_COUNT; i++)
+                {
+                    m_retired[i] += stats->counters[i].exchange(0);
+                }
+                m_free.emplace_back(stats);
+            }
+            hull_stats sum()
+            {
+                std::lock_guard<std::mutex> lock{ m_mutex };
+                std::uint64_t sum[COUNTER_COUNT]{};
+                for (int i{}; i < COUNTER_COUNT; i++)
+                {
+                    sum[i] = m_retired[i];
+                    for (hull_thread_stats* stats : m_blocks)
+                    {
+                        sum[i] += stats->counters[i].load(std::memory_order_relaxed);
+                    }
+                }
+                return
+                {
+                    sum[static_cast<int>(hull_counter::orientations)],
+                    sum[static_cast<int>(hull_counter::orientation_fallbacks)],
+                    sum[static_cast<int>(hull_counter::kill_zone_discarded)],
+                    sum[static_cast<int>(hull_counter::kill_zone_survivors)],
+                    sum[static_cast<int>(hull_counter::merge_tangent_steps)],
+                    sum[static_cast<int>(hull_counter::convexify_deletions)],
+                    sum[static_cast<int>(hull_counter::convexify_restarts)],
+                };
+            }
+            void reset()
+            {
+                std::lock_guard<std::mutex> lock{ m_mutex };
+                for (int i{}; i < COUNTER_COUNT; i++)
+                {
+                    m_retired[i] = 0;
+                    for (hull_thread_stats* stats : m_blocks)
+                    {
+                        stats->counters[i].store(0, std::memory_order_relaxed);
+                    }
+                }
+            }
+        private:
+            std::mutex m_mutex;
+            std::vector<hull_thread_stats*> m_blocks; // never freed, as threads keep pointers to them
+            std::vector<hull_thread_stats*> m_free;
+            std::uint64_t m_retired[COUNTER_COUNT]{};
+        };
+    }
+
+    hull_stats get_hull_stats()
+    {
+        return hull_stats_registry::instance().sum();
+    }
+
+    void reset_hull_stats()
+    {
+        hull_stats_registry::instance().reset();
+    }
+
+    hull_thread_stats* register_hull_stats()
+    {
+        // the block of the calling thread, given back when the thread exits
+        struct thread_block
+        {
+            hull_thread_stats* stats{ hull_stats_registry::instance().acquire() };
+            ~thread_block()
+            {
+                t_hull_stats = nullptr;
+                hull_stats_registry::instance().release(stats);
+            }
+        };
+        static thread_local thread_block t_block{};
+
+        t_hull_stats = t_block.stats;
+        return t_hull_stats;
+    }
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+/*
+    Operations are only counted if this is defined as 1, as the Debug and Stats configurations of the ConvexHull project do.
+    Counting sits inside orientation, on every call of every algorithm: off by default (and in Release, whose timings are
+    the ones to trust), count_hull_stat compiles to nothing.
+*/
+#ifndef CH_HULL_STATS
+    #define CH_HULL_STATS 0
+#endif
+
+namespace ch
+{
+    // whether this build counts operations at all (see CH_HULL_STATS)
+    constexpr bool HULL_STATS_ENABLED{ CH_HULL_STATS != 0 };
+
+    /*
+        Operation counts of the algorithms, to tell which stage is to blame when one of them is slower than expected.
+        Counters are kept per thread (so the parallel stages are counted too) and summed up on read: reset them, run an
+        algorithm, then read them back. All zero if CH_HULL_STATS is 0.
+    */
+    struct hull_stats
+    {
+        std::uint64_t orientations{};          // orientation predicate evaluations (i.e. signs of determinants)
+        std::uint64_t orientation_fallbacks{}; // orientations that needed exact arithmetic (see Predicates.h)
+        std::uint64_t kill_zone_discarded{};   // points dropped by the akl toussaint kill zone filter
+        std::uint64_t kill_zone_survivors{};   // points that made it through the kill zone filter
+        std::uint64_t merge_tangent_steps{};   // steps taken while walking the tangents of divide_and_conquer_merge
+        std::uint64_t convexify_deletions{};   // vertices dropped while convexifying a sorted path (torch, akl toussaint, monotone chain)
+        std::uint64_t convexify_restarts{};    // times convexifying a path had to step back over vertices already on it
+    };
+
+    enum class hull_counter
+    {
+        orientations,
+        orientation_fallbacks,
+        kill_zone_discarded,
+        kill_zone_survivors,
+        merge_tangent_steps,
+        convexify_deletions,
+        convexify_restarts,
+        count,
+    };
+
+    // counters of all the threads (also the ones that already exited), summed up
+    hull_stats get_hull_stats();
+    // zeroes the counters of all the threads. only exact while no other thread is running an algorithm (e.g. between benchmark runs)
+    void reset_hull_stats();
+
+    // counters of a single thread: only written by their own thread, but read by get_hull_stats from any thread
+    struct hull_thread_stats
+    {
+        std::atomic<std::uint64_t> counters[static_cast<int>(hull_counter::count)]{};
+    };
+
+    // counters of the calling thread, registered on its first count
+    inline thread_local hull_thread_stats* t_hull_stats{};
+    hull_thread_stats* register_hull_stats();
+
+    inline hull_thread_stats& thread_hull_stats()
+    {
+        hull_thread_stats* stats{ t_hull_stats };
+        return stats ? *stats : *register_hull_stats();
+    }
+
+    // a plain load and store, not an atomic increment: there is a single writer, and it keeps the fast paths cheap
+    inline void count_hull_stat([[maybe_unused]] hull_counter counter, [[maybe_unused]] std::uint64_t amount = 1)
+    {
+#if CH_HULL_STATS
+        std::atomic<std::uint64_t>& value{ thread_hull_stats().counters[static_cast<int>(counter)] };
+        value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+#endif
+    }
+}
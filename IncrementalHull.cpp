@@ -0,0 +1,56 @@
+#include <IncrementalHull.h>
+
+namespace ch
+{
+    bool incremental_hull::insert(v2 p)
+    {
+        if (contains(p))
+        {
+            return false;
+        }
+
+        v2 mirrored{ p.x, -p.y };
+        if (!chain_contains(m_upper, p))
+        {
+            chain_insert(m_upper, p);
+        }
+        if (!chain_contains(m_lower, mirrored))
+        {
+            chain_insert(m_lower, mirrored);
+        }
+        return true;
+    }
+
+    bool incremental_hull::contains(v2 p) const
+    {
+        return chain_contains(m_upper, p) && chain_contains(m_lower, { p.x, -p.y });
+    }
+
+    std::vector<v2> incremental_hull::hull() const
+    {
+        std::vector<v2> hull{};
+        if (empty())
+        {
+            return hull;
+        }
+
+        // upper chain from left to right
+        for (auto it{ m_upper.begin() }; it != m_upper.end(); it++)
+        {
+            hull.emplace_back(to_v2(it));
+        }
+
+        // lower chain from right to left, without the extremes shared with the upper chain
+        v2 first{ hull.front() };
+        v2 last{ hull.back() };
+        for (auto it{ m_lower.rbegin() }; it != m_lower.rend(); it++)
+        {
+            v2 p{ it->first, -it->second };
+            if (p != first && p != last)
+            {
+                hull.emplace_back(p);
+            }
+        }
+        return hull;
+    }
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <ConvexHull.h>
+#include <UpperChain.h>
+
+#include <vector>
+
+namespace ch
+{
+    /*
+        Convex hull of a set of points that only grows.
+        The hull is kept as two x-monotone chains (upper and lower) inside balanced search trees keyed by x, so that both
+        insert and contains are O(log h), amortized for insert (every hull vertex is removed at most once).
+        Points that fall inside the hull are rejected without touching the chains. Collinear hull points are not kept.
+    */
+    class incremental_hull
+    {
+    public:
+        incremental_hull() = default;
+    public:
+        // returns whether the hull changed, i.e. false if p was already inside of the hull (or on its boundary)
+        bool insert(v2 p);
+        // whether p is inside of the hull or on its boundary
+        bool contains(v2 p) const;
+        // clockwise hull, starting from the leftmost point
+        std::vector<v2> hull() const;
+        bool empty() const { return m_upper.empty(); }
+    private:
+        // x -> y of the vertices of the upper chain, from left to right
+        upper_chain m_upper;
+        // x -> -y of the vertices of the lower chain, from left to right. mirrored, so that it is handled as an upper chain
+        upper_chain m_lower;
+    };
+}
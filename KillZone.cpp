@@ -0,0 +1,447 @@
+#include <KillZone.h>
+
+#include <Predicates.h>
+
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <string>
+
+#if defined(_M_X64) || defined(__x86_64__)
+    #define CH_X86 1
+    #include <immintrin.h>
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+        #define CH_TARGET_AVX2
+    #else
+        #define CH_TARGET_AVX2 __attribute__((target("avx2")))
+    #endif
+#else
+    #define CH_X86 0
+#endif
+
+namespace ch
+{
+    template<typename T, typename Point>
+    static basic_kill_zone_planes<T> make_kill_zone_planes(const std::vector<Point>& kill_zone)
+    {
+        assert(kill_zone.size() <= 4);
+
+        basic_kill_zone_planes<T> planes{};
+        planes.count = static_cast<int>(kill_zone.size());
+        for (int i{}; i < planes.count; i++)
+        {
+            basic_v2<T> from{ static_cast<T>(kill_zone[i].x), static_cast<T>(kill_zone[i].y) };
+            basic_v2<T> to{ static_cast<T>(kill_zone[(i + 1) % planes.count].x), static_cast<T>(kill_zone[(i + 1) % planes.count].y) };
+            basic_v2<T> normal{ basic_v2<T>::normal(to - from) };
+            planes.from_x[i] = from.x;
+            planes.from_y[i] = from.y;
+            planes.normal_x[i] = normal.x;
+            planes.normal_y[i] = normal.y;
+        }
+        return planes;
+    }
+
+    kill_zone_planes make_kill_zone_planes(const std::vector<v2>& kill_zone)
+    {
+        return make_kill_zone_planes<double>(kill_zone);
+    }
+
+    kill_zone_planes_f make_kill_zone_planes(const std::vector<v2f>& kill_zone)
+    {
+        return make_kill_zone_planes<float>(kill_zone);
+    }
+
+    // int32 differences are exact in double precision
+    kill_zone_planes make_kill_zone_planes(const std::vector<v2i>& kill_zone)
+    {
+        return make_kill_zone_planes<double>(kill_zone);
+    }
+
+    // relative error bound of the half plane tests, evaluated in precision T: the same as orientation (see Predicates.h)
+    template<typename T>
+    static constexpr T FILTER_ERROR_BOUND{ (T{ 3 } + T{ 16 } * (std::numeric_limits<T>::epsilon() / 2)) * (std::numeric_limits<T>::epsilon() / 2) };
+
+    static_assert(FILTER_ERROR_BOUND<double> == ORIENTATION_ERROR_BOUND);
+
+    /*
+        A point falls within the kill zone, if all the half plane tests give back a negative dot product.
+        We do one half plane test for each side of the killzone. The dot product must be negative beyond its rounding error
+        (the same bound as orientation, see Predicates.h): points on or next to the boundary are kept, so that the exact
+        predicates of the algorithms decide on them.
+        No early exit and no branch on the outcome: every point is stored and the output cursor only advances for survivors.
+        Coordinates of type T are tested in precision U.
+    */
+    template<typename T, typename U>
+    static int filter_kill_zone_scalar(const basic_v2<T>* points, int count, const basic_kill_zone_planes<U>& planes, basic_v2<T>* survivors)
+    {
+        int survivors_count{};
+        for (int i{}; i < count; i++)
+        {
+            basic_v2<T> p{ points[i] };
+            bool falls_within{ true };
+            for (int j{}; j < planes.count; j++)
+            {
+                U t_x{ planes.normal_x[j] * (static_cast<U>(p.x) - planes.from_x[j]) };
+                U t_y{ planes.normal_y[j] * (static_cast<U>(p.y) - planes.from_y[j]) };
+                falls_within = falls_within & (t_x + t_y < -FILTER_ERROR_BOUND<U> * (std::abs(t_x) + std::abs(t_y)));
+            }
+            survivors[survivors_count] = p;
+            survivors_count += !falls_within;
+        }
+        return survivors_count;
+    }
+
+    static int filter_kill_zone_scalar(const double* xs, const double* ys, int count, const kill_zone_planes& planes, v2* survivors)
+    {
+        int survivors_count{};
+        for (int i{}; i < count; i++)
+        {
+            bool falls_within{ true };
+            for (int j{}; j < planes.count; j++)
+            {
+                double t_x{ planes.normal_x[j] * (xs[i] - planes.from_x[j]) };
+                double t_y{ planes.normal_y[j] * (ys[i] - planes.from_y[j]) };
+                falls_within = falls_within & (t_x + t_y < -ORIENTATION_ERROR_BOUND * (std::abs(t_x) + std::abs(t_y)));
+            }
+            survivors[survivors_count] = { xs[i], ys[i] };
+            survivors_count += !falls_within;
+        }
+        return survivors_count;
+    }
+
+#if CH_X86
+    // two points at a time
+    static int filter_kill_zone_sse2(const v2* points, int count, const kill_zone_planes& planes, v2* survivors)
+    {
+        __m128d sign{ _mm_set1_pd(-0.0) };
+        int survivors_count{};
+        int i{};
+        for (; i + 2 <= count; i += 2)
+        {
+            __m128d p0{ _mm_loadu_pd(&points[i + 0].x) }; // x0 y0
+            __m128d p1{ _mm_loadu_pd(&points[i + 1].x) }; // x1 y1
+            __m128d xs{ _mm_unpacklo_pd(p0, p1) }; // x0 x1
+            __m128d ys{ _mm_unpackhi_pd(p0, p1) }; // y0 y1
+
+            __m128d falls_within{ _mm_castsi128_pd(_mm_set1_epi32(-1)) };
+            for (int j{}; j < planes.count; j++)
+            {
+                __m128d dx{ _mm_sub_pd(xs, _mm_set1_pd(planes.from_x[j])) };
+                __m128d dy{ _mm_sub_pd(ys, _mm_set1_pd(planes.from_y[j])) };
+                __m128d t_x{ _mm_mul_pd(_mm_set1_pd(planes.normal_x[j]), dx) };
+                __m128d t_y{ _mm_mul_pd(_mm_set1_pd(planes.normal_y[j]), dy) };
+                __m128d magnitude{ _mm_add_pd(_mm_andnot_pd(sign, t_x), _mm_andnot_pd(sign, t_y)) };
+                __m128d bound{ _mm_mul_pd(_mm_set1_pd(-ORIENTATION_ERROR_BOUND), magnitude) };
+                falls_within = _mm_and_pd(falls_within, _mm_cmplt_pd(_mm_add_pd(t_x, t_y), bound));
+            }
+
+            // compress store
+            int mask{ _mm_movemask_pd(falls_within) };
+            _mm_storeu_pd(&survivors[survivors_count].x, p0);
+            survivors_count += !(mask & 1);
+            _mm_storeu_pd(&survivors[survivors_count].x, p1);
+            survivors_count += !(mask & 2);
+        }
+        return survivors_count + filter_kill_zone_scalar(points + i, count - i, planes, survivors + survivors_count);
+    }
+
+    static int filter_kill_zone_sse2(const double* xs, const double* ys, int count, const kill_zone_planes& planes, v2* survivors)
+    {
+        __m128d sign{ _mm_set1_pd(-0.0) };
+        int survivors_count{};
+        int i{};
+        for (; i + 2 <= count; i += 2)
+        {
+            __m128d px{ _mm_loadu_pd(xs + i) }; // x0 x1
+            __m128d py{ _mm_loadu_pd(ys + i) }; // y0 y1
+
+            __m128d falls_within{ _mm_castsi128_pd(_mm_set1_epi32(-1)) };
+            for (int j{}; j < planes.count; j++)
+            {
+                __m128d dx{ _mm_sub_pd(px, _mm_set1_pd(planes.from_x[j])) };
+                __m128d dy{ _mm_sub_pd(py, _mm_set1_pd(planes.from_y[j])) };
+                __m128d t_x{ _mm_mul_pd(_mm_set1_pd(planes.normal_x[j]), dx) };
+                __m128d t_y{ _mm_mul_pd(_mm_set1_pd(planes.normal_y[j]), dy) };
+                __m128d magnitude{ _mm_add_pd(_mm_andnot_pd(sign, t_x), _mm_andnot_pd(sign, t_y)) };
+                __m128d bound{ _mm_mul_pd(_mm_set1_pd(-ORIENTATION_ERROR_BOUND), magnitude) };
+                falls_within = _mm_and_pd(falls_within, _mm_cmplt_pd(_mm_add_pd(t_x, t_y), bound));
+            }
+
+            // compress store
+            int mask{ _mm_movemask_pd(falls_within) };
+            _mm_storeu_pd(&survivors[survivors_count].x, _mm_unpacklo_pd(px, py));
+            survivors_count += !(mask & 1);
+            _mm_storeu_pd(&survivors[survivors_count].x, _mm_unpackhi_pd(px, py));
+            survivors_count += !(mask & 2);
+        }
+        return survivors_count + filter_kill_zone_scalar(xs + i, ys + i, count - i, planes, survivors + survivors_count);
+    }
+
+    // four float points at a time
+    static int filter_kill_zone_sse2(const v2f* points, int count, const kill_zone_planes_f& planes, v2f* survivors)
+    {
+        __m128 sign{ _mm_set1_ps(-0.0f) };
+        __m128 minus_error_bound{ _mm_set1_ps(-FILTER_ERROR_BOUND<float>) };
+        int survivors_count{};
+        int i{};
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 a{ _mm_loadu_ps(&points[i + 0].x) }; // x0 y0 x1 y1
+            __m128 b{ _mm_loadu_ps(&points[i + 2].x) }; // x2 y2 x3 y3
+            __m128 xs{ _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)) }; // x0 x1 x2 x3
+            __m128 ys{ _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)) }; // y0 y1 y2 y3
+
+            __m128 falls_within{ _mm_castsi128_ps(_mm_set1_epi32(-1)) };
+            for (int j{}; j < planes.count; j++)
+            {
+                __m128 dx{ _mm_sub_ps(xs, _mm_set1_ps(planes.from_x[j])) };
+                __m128 dy{ _mm_sub_ps(ys, _mm_set1_ps(planes.from_y[j])) };
+                __m128 t_x{ _mm_mul_ps(_mm_set1_ps(planes.normal_x[j]), dx) };
+                __m128 t_y{ _mm_mul_ps(_mm_set1_ps(planes.normal_y[j]), dy) };
+                __m128 magnitude{ _mm_add_ps(_mm_andnot_ps(sign, t_x), _mm_andnot_ps(sign, t_y)) };
+                __m128 bound{ _mm_mul_ps(minus_error_bound, magnitude) };
+                falls_within = _mm_and_ps(falls_within, _mm_cmplt_ps(_mm_add_ps(t_x, t_y), bound));
+            }
+
+            // compress store
+            int mask{ _mm_movemask_ps(falls_within) };
+            for (int j{}; j < 4; j++)
+            {
+                survivors[survivors_count] = points[i + j];
+                survivors_count += !(mask & (1 << j));
+            }
+        }
+        return survivors_count + filter_kill_zone_scalar(points + i, count - i, planes, survivors + survivors_count);
+    }
+
+    // four points at a time
+    CH_TARGET_AVX2 static int filter_kill_zone_avx2(const v2* points, int count, const kill_zone_planes& planes, v2* survivors)
+    {
+        __m256d from_x[4]{}, from_y[4]{}, normal_x[4]{}, normal_y[4]{};
+        for (int j{}; j < planes.count; j++)
+        {
+            from_x[j] = _mm256_set1_pd(planes.from_x[j]);
+            from_y[j] = _mm256_set1_pd(planes.from_y[j]);
+            normal_x[j] = _mm256_set1_pd(planes.normal_x[j]);
+            normal_y[j] = _mm256_set1_pd(planes.normal_y[j]);
+        }
+        __m256d sign{ _mm256_set1_pd(-0.0) };
+        __m256d minus_error_bound{ _mm256_set1_pd(-ORIENTATION_ERROR_BOUND) };
+
+        int survivors_count{};
+        int i{};
+        for (; i + 4 <= count; i += 4)
+        {
+            __m256d a{ _mm256_loadu_pd(&points[i + 0].x) }; // x0 y0 x1 y1
+            __m256d b{ _mm256_loadu_pd(&points[i + 2].x) }; // x2 y2 x3 y3
+            __m256d xs{ _mm256_unpacklo_pd(a, b) }; // x0 x2 x1 x3
+            __m256d ys{ _mm256_unpackhi_pd(a, b) }; // y0 y2 y1 y3
+
+            __m256d falls_within{ _mm256_castsi256_pd(_mm256_set1_epi32(-1)) };
+            for (int j{}; j < planes.count; j++)
+            {
+                __m256d dx{ _mm256_sub_pd(xs, from_x[j]) };
+                __m256d dy{ _mm256_sub_pd(ys, from_y[j]) };
+                __m256d t_x{ _mm256_mul_pd(normal_x[j], dx) };
+                __m256d t_y{ _mm256_mul_pd(normal_y[j], dy) };
+                __m256d magnitude{ _mm256_add_pd(_mm256_andnot_pd(sign, t_x), _mm256_andnot_pd(sign, t_y)) };
+                __m256d bound{ _mm256_mul_pd(minus_error_bound, magnitude) };
+                falls_within = _mm256_and_pd(falls_within, _mm256_cmp_pd(_mm256_add_pd(t_x, t_y), bound, _CMP_LT_OQ));
+            }
+
+            // compress store (note that lanes hold points 0, 2, 1, 3)
+            int mask{ _mm256_movemask_pd(falls_within) };
+            _mm_storeu_pd(&survivors[survivors_count].x, _mm256_castpd256_pd128(a));
+            survivors_count += !(mask & 1);
+            _mm_storeu_pd(&survivors[survivors_count].x, _mm256_extractf128_pd(a, 1));
+            survivors_count += !(mask & 4);
+            _mm_storeu_pd(&survivors[survivors_count].x, _mm256_castpd256_pd128(b));
+            survivors_count += !(mask & 2);
+            _mm_storeu_pd(&survivors[survivors_count].x, _mm256_extractf128_pd(b, 1));
+            survivors_count += !(mask & 8);
+        }
+        return survivors_count + filter_kill_zone_scalar(points + i, count - i, planes, survivors + survivors_count);
+    }
+
+    CH_TARGET_AVX2 static int filter_kill_zone_avx2(const double* xs, const double* ys, int count, const kill_zone_planes& planes, v2* survivors)
+    {
+        __m256d from_x[4]{}, from_y[4]{}, normal_x[4]{}, normal_y[4]{};
+        for (int j{}; j < planes.count; j++)
+        {
+            from_x[j] = _mm256_set1_pd(planes.from_x[j]);
+            from_y[j] = _mm256_set1_pd(planes.from_y[j]);
+            normal_x[j] = _mm256_set1_pd(planes.normal_x[j]);
+            normal_y[j] = _mm256_set1_pd(planes.normal_y[j]);
+        }
+        __m256d sign{ _mm256_set1_pd(-0.0) };
+        __m256d minus_error_bound{ _mm256_set1_pd(-ORIENTATION_ERROR_BOUND) };
+
+        int survivors_count{};
+        int i{};
+        for (; i + 4 <= count; i += 4)
+        {
+            __m256d px{ _mm256_loadu_pd(xs + i) }; // x0 x1 x2 x3
+            __m256d py{ _mm256_loadu_pd(ys + i) }; // y0 y1 y2 y3
+
+            __m256d falls_within{ _mm256_castsi256_pd(_mm256_set1_epi32(-1)) };
+            for (int j{}; j < planes.count; j++)
+            {
+                __m256d dx{ _mm256_sub_pd(px, from_x[j]) };
+                __m256d dy{ _mm256_sub_pd(py, from_y[j]) };
+                __m256d t_x{ _mm256_mul_pd(normal_x[j], dx) };
+                __m256d t_y{ _mm256_mul_pd(normal_y[j], dy) };
+                __m256d magnitude{ _mm256_add_pd(_mm256_andnot_pd(sign, t_x), _mm256_andnot_pd(sign, t_y)) };
+                __m256d bound{ _mm256_mul_pd(minus_error_bound, magnitude) };
+                falls_within = _mm256_and_pd(falls_within, _mm256_cmp_pd(_mm256_add_pd(t_x, t_y), bound, _CMP_LT_OQ));
+            }
+
+            // compress store (interleave back to x0 y0 x2 y2 and x1 y1 x3 y3)
+            int mask{ _mm256_movemask_pd(falls_within) };
+            __m256d even{ _mm256_unpacklo_pd(px, py) };
+            __m256d odd{ _mm256_unpackhi_pd(px, py) };
+            _mm_storeu_pd(&survivors[survivors_count].x, _mm256_castpd256_pd128(even));
+            survivors_count += !(mask & 1);
+            _mm_storeu_pd(&survivors[survivors_count].x, _mm256_castpd256_pd128(odd));
+            survivors_count += !(mask & 2);
+            _mm_storeu_pd(&survivors[survivors_count].x, _mm256_extractf128_pd(even, 1));
+            survivors_count += !(mask & 4);
+            _mm_storeu_pd(&survivors[survivors_count].x, _mm256_extractf128_pd(odd, 1));
+            survivors_count += !(mask & 8);
+        }
+        return survivors_count + filter_kill_zone_scalar(xs + i, ys + i, count - i, planes, survivors + survivors_count);
+    }
+
+    // eight float points at a time
+    CH_TARGET_AVX2 static int filter_kill_zone_avx2(const v2f* points, int count, const kill_zone_planes_f& planes, v2f* survivors)
+    {
+        __m256 from_x[4]{}, from_y[4]{}, normal_x[4]{}, normal_y[4]{};
+        for (int j{}; j < planes.count; j++)
+        {
+            from_x[j] = _mm256_set1_ps(planes.from_x[j]);
+            from_y[j] = _mm256_set1_ps(planes.from_y[j]);
+            normal_x[j] = _mm256_set1_ps(planes.normal_x[j]);
+            normal_y[j] = _mm256_set1_ps(planes.normal_y[j]);
+        }
+        __m256 sign{ _mm256_set1_ps(-0.0f) };
+        __m256 minus_error_bound{ _mm256_set1_ps(-FILTER_ERROR_BOUND<float>) };
+
+        // lane of each point: shuffles work within 128 bit halves, so lanes hold points 0, 1, 4, 5, 2, 3, 6, 7
+        constexpr int POINT_LANES[8]{ 0, 1, 4, 5, 2, 3, 6, 7 };
+
+        int survivors_count{};
+        int i{};
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256 a{ _mm256_loadu_ps(&points[i + 0].x) }; // x0 y0 x1 y1 x2 y2 x3 y3
+            __m256 b{ _mm256_loadu_ps(&points[i + 4].x) }; // x4 y4 x5 y5 x6 y6 x7 y7
+            __m256 xs{ _mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)) }; // x0 x1 x4 x5 x2 x3 x6 x7
+            __m256 ys{ _mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)) }; // y0 y1 y4 y5 y2 y3 y6 y7
+
+            __m256 falls_within{ _mm256_castsi256_ps(_mm256_set1_epi32(-1)) };
+            for (int j{}; j < planes.count; j++)
+            {
+                __m256 dx{ _mm256_sub_ps(xs, from_x[j]) };
+                __m256 dy{ _mm256_sub_ps(ys, from_y[j]) };
+                __m256 t_x{ _mm256_mul_ps(normal_x[j], dx) };
+                __m256 t_y{ _mm256_mul_ps(normal_y[j], dy) };
+                __m256 magnitude{ _mm256_add_ps(_mm256_andnot_ps(sign, t_x), _mm256_andnot_ps(sign, t_y)) };
+                __m256 bound{ _mm256_mul_ps(minus_error_bound, magnitude) };
+                falls_within = _mm256_and_ps(falls_within, _mm256_cmp_ps(_mm256_add_ps(t_x, t_y), bound, _CMP_LT_OQ));
+            }
+
+            // compress store, in point order
+            int mask{ _mm256_movemask_ps(falls_within) };
+            for (int j{}; j < 8; j++)
+            {
+                survivors[survivors_count] = points[i + j];
+                survivors_count += !(mask & (1 << POINT_LANES[j]));
+            }
+        }
+        return survivors_count + filter_kill_zone_scalar(points + i, count - i, planes, survivors + survivors_count);
+    }
+
+    static bool cpu_has_avx2()
+    {
+    #if defined(_MSC_VER)
+        int info[4]{};
+        __cpuid(info, 0);
+        if (info[0] < 7)
+        {
+            return false;
+        }
+        __cpuid(info, 1);
+        bool os_saves_ymm{ (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 6) == 6 }; // OSXSAVE, AVX, XMM/YMM state
+        __cpuidex(info, 7, 0);
+        return os_saves_ymm && (info[1] & (1 << 5)) != 0;
+    #else
+        return __builtin_cpu_supports("avx2");
+    #endif
+    }
+#endif
+
+    using filter_kill_zone_fn = int(*)(const v2*, int, const kill_zone_planes&, v2*);
+    using filter_kill_zone_soa_fn = int(*)(const double*, const double*, int, const kill_zone_planes&, v2*);
+    using filter_kill_zone_f32_fn = int(*)(const v2f*, int, const kill_zone_planes_f&, v2f*);
+
+    struct filter_kill_zone_kernel
+    {
+        filter_kill_zone_fn fn{};
+        filter_kill_zone_soa_fn soa_fn{};
+        filter_kill_zone_f32_fn f32_fn{};
+        const char* name{};
+    };
+
+    static filter_kill_zone_kernel select_kernel()
+    {
+        std::string cap{};
+        if (const char* env{ std::getenv("CH_SIMD") })
+        {
+            cap = env;
+        }
+
+    #if CH_X86
+        if (cap != "scalar" && cap != "sse2" && cpu_has_avx2())
+        {
+            return { filter_kill_zone_avx2, filter_kill_zone_avx2, filter_kill_zone_avx2, "avx2" };
+        }
+        if (cap != "scalar")
+        {
+            return { filter_kill_zone_sse2, filter_kill_zone_sse2, filter_kill_zone_sse2, "sse2" }; // always available on x86-64
+        }
+    #endif
+        return { filter_kill_zone_scalar, filter_kill_zone_scalar, filter_kill_zone_scalar, "scalar" };
+    }
+
+    static const filter_kill_zone_kernel& kernel()
+    {
+        static const filter_kill_zone_kernel selected{ select_kernel() };
+        return selected;
+    }
+
+    int filter_kill_zone(const v2* points, int count, const kill_zone_planes& planes, v2* survivors)
+    {
+        return kernel().fn(points, count, planes, survivors);
+    }
+
+    int filter_kill_zone(const double* xs, const double* ys, int count, const kill_zone_planes& planes, v2* survivors)
+    {
+        return kernel().soa_fn(xs, ys, count, planes, survivors);
+    }
+
+    int filter_kill_zone(const v2f* points, int count, const kill_zone_planes_f& planes, v2f* survivors)
+    {
+        return kernel().f32_fn(points, count, planes, survivors);
+    }
+
+    int filter_kill_zone(const v2i* points, int count, const kill_zone_planes& planes, v2i* survivors)
+    {
+        return filter_kill_zone_scalar(points, count, planes, survivors);
+    }
+
+    const char* kill_zone_kernel_name()
+    {
+        return kernel().name;
+    }
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <ConvexHull.h>
+
+#include <vector>
+
+namespace ch
+{
+    /*
+        Half planes of the Akl-Toussaint kill zone, precomputed once for the whole filtering pass.
+        For the i-th side (from -> to) of the kill zone we store "from" and the normal to "from -> to".
+        Float points are filtered in float precision (twice the lanes of double), int32 points in double precision.
+    */
+    template<typename T>
+    struct basic_kill_zone_planes
+    {
+        int count{};
+        T from_x[4]{};
+        T from_y[4]{};
+        T normal_x[4]{};
+        T normal_y[4]{};
+    };
+
+    using kill_zone_planes = basic_kill_zone_planes<double>;
+    using kill_zone_planes_f = basic_kill_zone_planes<float>;
+
+    kill_zone_planes make_kill_zone_planes(const std::vector<v2>& kill_zone);
+    kill_zone_planes_f make_kill_zone_planes(const std::vector<v2f>& kill_zone);
+    kill_zone_planes make_kill_zone_planes(const std::vector<v2i>& kill_zone);
+
+    /*
+        Writes to survivors the points that don't fall within the kill zone, in their original order, and returns how many they are.
+        survivors must have room for count points. The best kernel supported by the CPU is picked at run time
+        (AVX2, SSE2 or scalar). The CH_SIMD environment variable (avx2, sse2 or scalar) caps the kernel level.
+        All the kernels evaluate exactly the same floating point expressions, hence they agree on every point.
+    */
+    int filter_kill_zone(const v2* points, int count, const kill_zone_planes& planes, v2* survivors);
+
+    // same as above, for points stored as a structure of arrays (see point_set)
+    int filter_kill_zone(const double* xs, const double* ys, int count, const kill_zone_planes& planes, v2* survivors);
+
+    // same as above, for float points (AVX2 filters eight points at a time) and for int32 points (scalar kernel only)
+    int filter_kill_zone(const v2f* points, int count, const kill_zone_planes_f& planes, v2f* survivors);
+    int filter_kill_zone(const v2i* points, int count, const kill_zone_planes& planes, v2i* survivors);
+
+    // name of the kernel used by filter_kill_zone
+    const char* kill_zone_kernel_name();
+}
@@ -1,70 +1,98 @@
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <chrono>
 #include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <filesystem>
 #include <iostream>
 #include <fstream>
 #include <format>
 #include <functional>
+#include <iomanip>
+#include <limits>
+#include <new>
 #include <random>
 #include <vector>
 
+#include <BatchHull.h>
+#include <Benchmark.h>
 #include <ConvexHull.h>
-
-static bool are_collinear(ch::v2 u, ch::v2 v, ch::v2 w, double threshold = 1.0)
+#include <Dataset.h>
+#include <DynamicHull.h>
+#include <HullSelection.h>
+#include <HullStats.h>
+#include <IncrementalHull.h>
+#include <KillZone.h>
+#include <Parallel.h>
+#include <PointIO.h>
+#include <PointSet.h>
+#include <Predicates.h>
+#include <SlidingWindowHull.h>
+#include <Trace.h>
+
+// number of heap allocations performed so far, so that the benchmark can report how much each algorithm allocates
+static std::atomic<long long> g_allocations_count{};
+
+void* operator new(std::size_t size)
 {
-    ch::v2 u_to_v{ v - u };
-    ch::v2 u_to_w{ w - u };
-    return std::abs(ch::determinant(u_to_v, u_to_w)) < threshold;
+    g_allocations_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* p{ std::malloc(size == 0 ? 1 : size) })
+    {
+        return p;
+    }
+    throw std::bad_alloc{};
 }
-
-static std::vector<ch::v2> generate_points(int points_count)
+void operator delete(void* p) noexcept
 {
-    assert(points_count >= 3);
-
-    std::random_device random_device{};
-    std::mt19937 generator{ random_device() };
-    //std::mt19937 generator{ 1 };
-    std::uniform_real_distribution<> distribution{ 0.0, static_cast<double>(points_count) * 10.0 };
+    std::free(p);
+}
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
 
-    std::vector<ch::v2> points{};
-    while (points.size() < points_count)
+// aligned allocations (e.g. the coordinate arrays of ch::point_set) are counted as well
+#if defined(_MSC_VER)
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    g_allocations_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* p{ _aligned_malloc(size == 0 ? 1 : size, static_cast<std::size_t>(alignment)) })
     {
-        double x{ distribution(generator) };
-        double y{ distribution(generator) };
-        ch::v2 p{ x, y };
-
-        bool discard{ false };
-
-        // check that two points don't have the same (or close) x or y coordinates
-        for (int i{}; i < static_cast<int>(points.size()) && !discard; i++)
-        {
-            ch::v2 q{ points[i] };
-            double dx{ std::abs(p.x - q.x) };
-            double dy{ std::abs(p.y - q.y) };
-
-            if (dx < 1.0 || dy < 1.0) // TODO: 1.0 should change based on points count?
-            {
-                discard = true;
-            }
-        }
-
-        // check whether or not we should discard p (if p is collinear to any other two previously generated points, trash it)
-        for (int i{}; i < static_cast<int>(points.size()) && !discard; i++)
-        {
-            for (int j{ i + 1 }; j < static_cast<int>(points.size()) && !discard; j++)
-            {
-                discard = are_collinear(p, points[i], points[j], 1.0);
-            }
-        }
-
-        if (!discard)
-        {
-            points.emplace_back(p);
-        }
+        return p;
     }
-
-    return points;
+    throw std::bad_alloc{};
+}
+void operator delete(void* p, std::align_val_t) noexcept
+{
+    _aligned_free(p);
+}
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept
+{
+    _aligned_free(p);
+}
+#else
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    g_allocations_count.fetch_add(1, std::memory_order_relaxed);
+    std::size_t align{ static_cast<std::size_t>(alignment) };
+    if (void* p{ std::aligned_alloc(align, (size + align - 1) / align * align) })
+    {
+        return p;
+    }
+    throw std::bad_alloc{};
+}
+void operator delete(void* p, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept
+{
+    std::free(p);
 }
+#endif
 
 static bool validate_hull(const std::vector<ch::v2>& truth, const std::vector<ch::v2>& hull)
 {
@@ -223,13 +251,13 @@ void Logger::log(const std::string& msg)
     m_log_file.flush();
 }
 
-static std::vector<ch::v2> generate_dataset(Logger& logger, int capacity)
+static std::vector<ch::v2> generate_dataset(Logger& logger, int capacity, std::uint64_t seed = std::random_device{}())
 {
     std::vector<ch::v2> dataset{};
     {
-        logger.log("generating points ... ");
+        logger.logf("generating points (seed {}) ... ", seed);
         auto start{ std::chrono::high_resolution_clock::now() };
-        dataset = generate_points(capacity);
+        dataset = ch::generate_points(ch::distribution::square, capacity, seed);
         auto end{ std::chrono::high_resolution_clock::now() };
         auto duration_str{ format_duration(end - start) };
         logger.logf("DONE ... {}\n", duration_str);
@@ -237,7 +265,24 @@ static std::vector<ch::v2> generate_dataset(Logger& logger, int capacity)
     return dataset;
 }
 
-using HullFn = std::function<std::vector<ch::v2>(std::vector<ch::v2>)>;
+// same as generate_dataset, but the dataset goes through the on disk cache
+static std::vector<ch::v2> load_dataset(Logger& logger, ch::distribution distribution, int capacity, std::uint64_t seed)
+{
+    std::vector<ch::v2> dataset{};
+    {
+        logger.logf("loading {} points (seed {}) ... ", ch::distribution_name(distribution), seed);
+        auto start{ std::chrono::high_resolution_clock::now() };
+        bool cache_hit{};
+        dataset = ch::load_or_generate_points(distribution, capacity, seed, "datasets", &cache_hit);
+        auto end{ std::chrono::high_resolution_clock::now() };
+        auto duration_str{ format_duration(end - start) };
+        logger.logf("DONE ({}) ... {}\n", cache_hit ? "cached" : "generated", duration_str);
+    }
+    return dataset;
+}
+
+// plain function pointer, so that overloaded algorithms (std::vector<ch::v2> and ch::point_set) resolve to the std::vector<ch::v2> one
+using HullFn = std::vector<ch::v2>(*)(const std::vector<ch::v2>&);
 static void test(Logger& logger, std::vector<ch::v2> dataset, HullFn oracle, const std::string& oracle_name, HullFn func, const std::string& func_name)
 {
     std::random_device rd{};
@@ -341,6 +386,20 @@ static void test_dc_akl_toussaint_against_dc()
     test(logger, dataset, ch::divide_and_conquer, "divide and conquer", ch::divide_and_conquer_akl_toussaint, "divide and conquer akl-toussaint");
 }
 
+static void test_dc_parallel_against_dc()
+{
+    Logger logger{};
+
+    logger.log("parallel divide and conquer against divide and conquer\n");
+
+    int dataset_capacity{ 100000 };
+    logger.log("--------------------------------------------------------------------------------\n");
+    logger.logf("dataset capacity: {}\n", dataset_capacity);
+
+    std::vector<ch::v2> dataset{ generate_dataset(logger, dataset_capacity) };
+    test(logger, dataset, ch::divide_and_conquer, "divide and conquer", ch::divide_and_conquer_parallel, "parallel divide and conquer");
+}
+
 static void test_torch_akl_toussaint_against_torch()
 {
     Logger logger{};
@@ -355,192 +414,1332 @@ static void test_torch_akl_toussaint_against_torch()
     test(logger, dataset, ch::torch, "torch", ch::torch_akl_toussaint, "torch akl-toussaint");
 }
 
-static void test_sample_points_for_subset()
+static void test_monotone_chain_against_dc()
 {
     Logger logger{};
 
-    logger.log("test sample points for subset\n");
+    logger.log("monotone chain against divide and conquer\n");
 
     int dataset_capacity{ 10000 };
     logger.log("--------------------------------------------------------------------------------\n");
     logger.logf("dataset capacity: {}\n", dataset_capacity);
 
     std::vector<ch::v2> dataset{ generate_dataset(logger, dataset_capacity) };
+    test(logger, dataset, ch::divide_and_conquer, "divide and conquer", ch::monotone_chain, "monotone chain");
+}
 
-    std::random_device rd{};
-    std::mt19937 gen{ rd() };
-    std::uniform_int_distribution<> points_count_increment_distrib{ 5, 100 };
-    int points_count{ points_count_increment_distrib(gen) };
-    while (points_count < static_cast<int>(dataset.size()))
-    {
-        std::uniform_int_distribution<> k_increment_distrib{ 1, points_count / 2 };
-        int k{ k_increment_distrib(gen) };
-        while (k < points_count)
-        {
-            logger.log("--------------------------------------------------------------------------------\n");
-            logger.logf("points count: {}\n", points_count);
-            logger.logf("k: {}\n", k);
+static void test_quickhull_against_akl_toussaint()
+{
+    Logger logger{};
 
-            // copy portion of point dataset
-            std::vector<ch::v2> points{ dataset.begin(), dataset.begin() + points_count };
+    logger.log("quickhull against akl-toussaint\n");
 
-            logger.log("sampling ... ");
-            std::vector<ch::v2> points_sample{};
-            {
-                auto start{ std::chrono::high_resolution_clock::now() };
-                points_sample = ch::sample_points_for_subset(points, k);
-                auto end{ std::chrono::high_resolution_clock::now() };
-                auto us{ std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() };
-                logger.logf("DONE ... {} us\n", us);
-            }
+    int dataset_capacity{ 100000 };
+    logger.log("--------------------------------------------------------------------------------\n");
+    logger.logf("dataset capacity: {}\n", dataset_capacity);
 
-            logger.log("computing approximate convex hull ... ");
-            std::vector<ch::v2> approximate_hull{};
-            {
-                auto start{ std::chrono::high_resolution_clock::now() };
-                approximate_hull = ch::akl_toussaint(points_sample);
-                auto end{ std::chrono::high_resolution_clock::now() };
-                auto us{ std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() };
-                logger.logf("DONE ... {} us\n", us);
-            }
+    std::vector<ch::v2> dataset{ generate_dataset(logger, dataset_capacity) };
+    test(logger, dataset, ch::akl_toussaint, "akl-toussaint", ch::quickhull, "quickhull");
+}
 
-            logger.log("computing correct convex hull ... ");
-            std::vector<ch::v2> hull{};
-            {
-                auto start{ std::chrono::high_resolution_clock::now() };
-                hull = ch::akl_toussaint(points);
-                auto end{ std::chrono::high_resolution_clock::now() };
-                auto us{ std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() };
-                logger.logf("DONE ... {} us\n", us);
-            }
+static void test_chan_against_akl_toussaint()
+{
+    Logger logger{};
 
-            if (validate_points_subset(points, points_sample, hull, approximate_hull))
-            {
-                logger.log("points sample is OK\n");
-            }
-            else
-            {
-                logger.log("points sample is WRONG\n");
-            }
+    logger.log("chan against akl-toussaint\n");
 
-            k += k_increment_distrib(gen);
-        }
+    int dataset_capacity{ 100000 };
+    logger.log("--------------------------------------------------------------------------------\n");
+    logger.logf("dataset capacity: {}\n", dataset_capacity);
 
-        points_count += points_count_increment_distrib(gen);
-    }
+    std::vector<ch::v2> dataset{ generate_dataset(logger, dataset_capacity) };
+    test(logger, dataset, ch::akl_toussaint, "akl-toussaint", ch::chan, "chan");
 }
 
-static void benchmark()
+static void test_kirkpatrick_seidel_against_akl_toussaint()
 {
     Logger logger{};
-    logger.log("--------------------------------------------------------------------------------\n");
-    logger.log("Benchmark\n");
 
-    int dataset_capacity{ 10000 };
+    logger.log("kirkpatrick-seidel against akl-toussaint\n");
+
+    int dataset_capacity{ 100000 };
     logger.log("--------------------------------------------------------------------------------\n");
     logger.logf("dataset capacity: {}\n", dataset_capacity);
 
     std::vector<ch::v2> dataset{ generate_dataset(logger, dataset_capacity) };
+    test(logger, dataset, ch::akl_toussaint, "akl-toussaint", ch::kirkpatrick_seidel, "kirkpatrick-seidel");
+}
 
-    constexpr int N{ 7 };
+static void test_incremental_hull_against_akl_toussaint()
+{
+    Logger logger{};
 
-    HullFn algorithms[N]
-    {
-        ch::naive,
-        ch::divide_and_conquer,
-        ch::akl_toussaint,
-        ch::torch,
-        ch::naive_akl_toussaint,
-        ch::divide_and_conquer_akl_toussaint,
-        ch::torch_akl_toussaint,
-    };
-    const char* algorithms_names[N]
-    {
-        "naive",
-        "divide_and_conquer",
-        "akl_toussaint",
-        "torch",
-        "naive_akl_toussaint",
-        "divide_and_conquer_akl_toussaint",
-        "torch_akl_toussaint",
-    };
+    logger.log("incremental hull against akl-toussaint\n");
+
+    int dataset_capacity{ 10000 };
+    logger.log("--------------------------------------------------------------------------------\n");
+    logger.logf("dataset capacity: {}\n", dataset_capacity);
+
+    std::vector<ch::v2> dataset{ generate_dataset(logger, dataset_capacity) };
 
-    for (int i{}; i < N; i++)
+    std::random_device rd{};
+    std::mt19937 gen{ rd() };
+    std::uniform_int_distribution<> distrib{ 5, 100 };
+    ch::incremental_hull incremental_hull{};
+    int inserted_count{};
+    int points_count{ distrib(gen) };
+    while (points_count < static_cast<int>(dataset.size()))
     {
         logger.log("--------------------------------------------------------------------------------\n");
-        logger.logf("{}\n", algorithms_names[i]);
+        logger.logf("points count: {}\n", points_count);
 
-        int points_count{ 100 };
-        constexpr long long ALLOTTED_SECONDS_FOR_ALGO_BENCHMARK{ 60 * 3 }; // three minutes
-        long long seconds_since_algo_benchmark_start{};
-        while (points_count < static_cast<int>(dataset.size()))
+        // insert the points that are new in this portion of the dataset
+        for (; inserted_count < points_count; inserted_count++)
         {
-            // copy portion of point dataset
-            std::vector<ch::v2> points{ dataset.begin(), dataset.begin() + points_count };
+            incremental_hull.insert(dataset[inserted_count]);
+        }
 
-            // run benchmark /w timing data
-            auto start{ std::chrono::high_resolution_clock::now() };
-            std::vector<ch::v2> hull{ algorithms[i](points) };
-            auto end{ std::chrono::high_resolution_clock::now() };
+        std::vector<ch::v2> points{ dataset.begin(), dataset.begin() + points_count };
+        bool hull_match{ validate_hull(ch::akl_toussaint(points), incremental_hull.hull()) };
+        bool contains_all{ std::all_of(points.begin(), points.end(), [&](ch::v2 p) { return incremental_hull.contains(p); }) };
+        if (hull_match && contains_all)
+        {
+            logger.log("hulls MATCH\n");
+        }
+        else
+        {
+            logger.logf("hulls DON'T MATCH (hull {}, contains {})\n", hull_match, contains_all);
+        }
 
-            // print benchmark data point
-            auto us{ std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() };
-            logger.logf("n={} t={}\n", points_count, us);
+        points_count += distrib(gen);
+    }
+}
 
-            // if it took more than one minute, it is probably too slow to go up to 10k points
-            seconds_since_algo_benchmark_start += std::chrono::duration_cast<std::chrono::seconds>(end - start).count();
-            if (seconds_since_algo_benchmark_start >= ALLOTTED_SECONDS_FOR_ALGO_BENCHMARK)
-            {
-                break;
-            }
+static void test_dynamic_hull_against_akl_toussaint()
+{
+    Logger logger{};
+
+    logger.log("dynamic hull against akl-toussaint\n");
+
+    int dataset_capacity{ 10000 };
+    logger.log("--------------------------------------------------------------------------------\n");
+    logger.logf("dataset capacity: {}\n", dataset_capacity);
+
+    std::vector<ch::v2> dataset{ generate_dataset(logger, dataset_capacity) };
+
+    std::random_device rd{};
+    std::mt19937 gen{ rd() };
+    std::uniform_int_distribution<> distrib{ 5, 100 };
+    ch::dynamic_hull dynamic_hull{};
+    std::vector<ch::v2> points{};
+    int inserted_count{};
+    while (inserted_count < static_cast<int>(dataset.size()))
+    {
+        // insert a batch of new points, then erase some random ones
+        int insert_count{ std::min(distrib(gen), static_cast<int>(dataset.size()) - inserted_count) };
+        for (int i{}; i < insert_count; i++, inserted_count++)
+        {
+            dynamic_hull.insert(dataset[inserted_count]);
+            points.emplace_back(dataset[inserted_count]);
+        }
+        int erase_count{ std::uniform_int_distribution<>{ 0, insert_count / 2 }(gen) };
+        for (int i{}; i < erase_count && points.size() > 5; i++)
+        {
+            int erased{ std::uniform_int_distribution<>{ 0, static_cast<int>(points.size()) - 1 }(gen) };
+            dynamic_hull.erase(points[erased]);
+            points[erased] = points.back();
+            points.pop_back();
+        }
+
+        logger.log("--------------------------------------------------------------------------------\n");
+        logger.logf("points count: {}\n", points.size());
 
-            // go to the next benchmark data point
-            points_count += 100;
+        if (static_cast<int>(points.size()) == dynamic_hull.size() && validate_hull(ch::akl_toussaint(points), dynamic_hull.hull()))
+        {
+            logger.log("hulls MATCH\n");
+        }
+        else
+        {
+            logger.log("hulls DON'T MATCH\n");
         }
     }
 }
 
-#if 0
-int main()
+static void test_sliding_window_hull_against_akl_toussaint()
 {
-    // generate points
-    int points_count{ 500 };
-    std::vector<ch::v2> points{ generate_points(points_count) };
-    assert(points.size() == points_count); // sanity check
+    Logger logger{};
 
-    // generate hull and test against oracle
-    //std::vector<ch::v2> naive_hull{ ch::naive(points) };
-    //std::vector<ch::v2> dc_hull{ ch::divide_and_conquer(points) };
-    #if 1
-    std::vector<ch::v2> akl_toussaint_hull{ ch::akl_toussaint(points) };
-    std::vector<ch::v2> torch_hull{ ch::torch(points) };
-    dump_points_and_hull(points, torch_hull);
-    #else
-    std::vector<ch::v2> sampled_points{ ch::sample_points_for_subset(points, 9) };
-    dump_points_and_hull(sampled_points, {});
-    #endif
+    logger.log("sliding window hull against akl-toussaint\n");
 
-    #if 1
-    if (!validate_hull(akl_toussaint_hull, torch_hull))
+    int dataset_capacity{ 10000 };
+    logger.log("--------------------------------------------------------------------------------\n");
+    logger.logf("dataset capacity: {}\n", dataset_capacity);
+
+    std::vector<ch::v2> dataset{ generate_dataset(logger, dataset_capacity) };
+
+    std::random_device rd{};
+    std::mt19937 gen{ rd() };
+    std::uniform_int_distribution<> distrib{ 5, 1000 };
+    int window_size{ distrib(gen) };
+    logger.logf("window size: {}\n", window_size);
+
+    // the point at index i is pushed at time i
+    ch::sliding_window_hull sliding_window_hull{};
+    std::deque<ch::v2> window{};
+    for (int i{}; i < static_cast<int>(dataset.size()); i++)
     {
-        std::cerr << "hull validation failed" << std::endl;
-        return -1;
-    }
-    #endif
+        sliding_window_hull.push(dataset[i], static_cast<double>(i));
+        window.emplace_back(dataset[i]);
+        sliding_window_hull.expire_before(static_cast<double>(i - window_size + 1));
+        if (static_cast<int>(window.size()) > window_size)
+        {
+            window.pop_front();
+        }
 
-    return 0;
+        if (i % 100 != 99)
+        {
+            continue;
+        }
+
+        logger.log("--------------------------------------------------------------------------------\n");
+        logger.logf("points pushed: {}\n", i + 1);
+
+        std::vector<ch::v2> points{ window.begin(), window.end() };
+        if (static_cast<int>(points.size()) == sliding_window_hull.size() && validate_hull(ch::akl_toussaint(points), sliding_window_hull.hull()))
+        {
+            logger.log("hulls MATCH\n");
+        }
+        else
+        {
+            logger.log("hulls DON'T MATCH\n");
+        }
+    }
 }
-#else
-int main()
+
+static void test_batch_hulls_against_monotone_chain()
 {
-    //test_akl_toussaint_against_dc();
-    //test_torch_against_akl_toussaint();
-    //test_naive_akl_toussaint_against_naive();
-    //test_dc_akl_toussaint_against_dc();
-    //test_torch_akl_toussaint_against_torch();
+    Logger logger{};
 
-    //test_sample_points_for_subset();
+    logger.log("batch hulls against monotone chain\n");
 
-    benchmark();
+    int dataset_capacity{ 100000 };
+    logger.log("--------------------------------------------------------------------------------\n");
+    logger.logf("dataset capacity: {}\n", dataset_capacity);
+
+    std::vector<ch::v2> dataset{ generate_dataset(logger, dataset_capacity) };
+
+    // split the dataset in groups of random sizes
+    std::random_device rd{};
+    std::mt19937 gen{ rd() };
+    std::uniform_int_distribution<> distrib{ 3, 200 };
+    std::vector<int> offsets{ 0 };
+    while (offsets.back() < static_cast<int>(dataset.size()))
+    {
+        offsets.emplace_back(std::min(offsets.back() + distrib(gen), static_cast<int>(dataset.size())));
+    }
+    if (offsets.back() - offsets[offsets.size() - 2] < 3)
+    {
+        offsets.erase(offsets.end() - 2); // the last group is merged with the one before it
+    }
+    logger.logf("groups count: {}\n", offsets.size() - 1);
+
+    ch::point_groups hulls{ ch::batch_hulls(dataset, offsets) };
+
+    int mismatches{};
+    for (int i{}; i + 1 < static_cast<int>(offsets.size()); i++)
+    {
+        std::vector<ch::v2> group{ dataset.begin() + offsets[i], dataset.begin() + offsets[i + 1] };
+        std::span<const ch::v2> hull{ hulls.group(i) };
+        if (!validate_hull(ch::monotone_chain(group), { hull.begin(), hull.end() }))
+        {
+            mismatches++;
+        }
+    }
+
+    logger.log("--------------------------------------------------------------------------------\n");
+    if (hulls.size() == static_cast<int>(offsets.size()) - 1 && mismatches == 0)
+    {
+        logger.log("hulls MATCH\n");
+    }
+    else
+    {
+        logger.logf("hulls DON'T MATCH ({} groups)\n", mismatches);
+    }
+}
+
+static void test_degenerate_inputs()
+{
+    Logger logger{};
+
+    logger.log("degenerate inputs against monotone chain\n");
+
+    std::random_device rd{};
+    std::uint64_t seed{ rd() };
+    std::mt19937 gen{ static_cast<std::mt19937::result_type>(seed) };
+    logger.logf("seed: {}\n", seed);
+
+    // lattices, exactly collinear points (with duplicates), identical points and nearly collinear points
+    std::vector<std::pair<std::string, std::vector<ch::v2>>> datasets{};
+    for (int count : { 5, 20, 100, 1000, 10000 })
+    {
+        datasets.emplace_back(std::format("lattice {}", count), ch::generate_points(ch::distribution::lattice, count, seed + count));
+    }
+    {
+        std::vector<ch::v2> horizontal{}, vertical{}, diagonal{}, identical{}, near_collinear{}, near_collinear_triangle{};
+        std::uniform_int_distribution<> distrib{ 0, 99 };
+        for (int i{}; i < 1000; i++)
+        {
+            double t{ static_cast<double>(distrib(gen)) };
+            horizontal.emplace_back(t, 7.0);
+            vertical.emplace_back(7.0, t);
+            diagonal.emplace_back(t, 3.0 * t + 1.0);
+            identical.emplace_back(3.0, 5.0);
+            // 0.1 is not a double: these points are only nearly collinear, and on which side they are is up to rounding
+            near_collinear.emplace_back(0.1 * t, 0.3 * t);
+            near_collinear_triangle.emplace_back(i % 10 == 0 ? ch::v2{ 5.0, -1e-12 } : ch::v2{ 0.1 * t, 0.3 * t });
+        }
+        datasets.emplace_back("horizontal", horizontal);
+        datasets.emplace_back("vertical", vertical);
+        datasets.emplace_back("diagonal", diagonal);
+        datasets.emplace_back("identical", identical);
+        datasets.emplace_back("near collinear", near_collinear);
+        datasets.emplace_back("near collinear triangle", near_collinear_triangle);
+    }
+
+    std::pair<const char*, HullFn> algorithms[]
+    {
+        { "divide and conquer", ch::divide_and_conquer },
+        { "akl-toussaint", ch::akl_toussaint },
+        { "torch", ch::torch },
+        { "quickhull", ch::quickhull },
+        { "chan", ch::chan },
+        { "kirkpatrick-seidel", ch::kirkpatrick_seidel },
+        { "divide and conquer parallel", ch::divide_and_conquer_parallel },
+        { "divide and conquer akl-toussaint", ch::divide_and_conquer_akl_toussaint },
+        { "torch akl-toussaint", ch::torch_akl_toussaint },
+        { "kirkpatrick-seidel akl-toussaint", ch::kirkpatrick_seidel_akl_toussaint },
+        { "akl-toussaint (point set)", [](const std::vector<ch::v2>& points) { return ch::akl_toussaint(ch::point_set{ points }); } },
+        { "torch (point set)", [](const std::vector<ch::v2>& points) { return ch::torch(ch::point_set{ points }); } },
+        { "divide and conquer (point set)", [](const std::vector<ch::v2>& points) { return ch::divide_and_conquer(ch::point_set{ points }); } },
+        { "incremental hull", [](const std::vector<ch::v2>& points)
+            {
+                ch::incremental_hull hull{};
+                for (ch::v2 p : points)
+                {
+                    hull.insert(p);
+                }
+                return hull.hull();
+            }
+        },
+        { "batch hulls", [](const std::vector<ch::v2>& points)
+            {
+                ch::point_groups hulls{ ch::batch_hulls(points, std::vector<int>{ 0, static_cast<int>(points.size()) }) };
+                return std::vector<ch::v2>{ hulls.group(0).begin(), hulls.group(0).end() };
+            }
+        },
+    };
+
+    for (auto& [name, dataset] : datasets)
+    {
+        logger.log("--------------------------------------------------------------------------------\n");
+        logger.logf("{}\n", name);
+
+        std::shuffle(dataset.begin(), dataset.end(), gen);
+        std::vector<std::string> mismatches{};
+        for (int points_count : { 3, 4, 5, 10, 100, static_cast<int>(dataset.size()) })
+        {
+            if (points_count > static_cast<int>(dataset.size()))
+            {
+                continue;
+            }
+            std::vector<ch::v2> points{ dataset.begin(), dataset.begin() + points_count };
+            std::vector<ch::v2> oracle_hull{ ch::monotone_chain(points) };
+            auto check{ [&](const std::string& func_name, const std::vector<ch::v2>& hull)
+                {
+                    if (!validate_hull(oracle_hull, hull))
+                    {
+                        mismatches.emplace_back(std::format("{} ({} points)", func_name, points_count));
+                    }
+                } };
+
+            // naive is O(n^3)
+            if (points_count <= 100)
+            {
+                check("naive", ch::naive(points));
+                check("naive akl-toussaint", ch::naive_akl_toussaint(points));
+            }
+            for (auto [func_name, func] : algorithms)
+            {
+                check(func_name, func(points));
+            }
+
+            // dynamic hull: insert everything, then erase half of the distinct points
+            ch::dynamic_hull dynamic_hull{};
+            std::vector<ch::v2> distinct{};
+            for (ch::v2 p : points)
+            {
+                if (dynamic_hull.insert(p))
+                {
+                    distinct.emplace_back(p);
+                }
+            }
+            check("dynamic hull (insert)", dynamic_hull.hull());
+            for (int i{}; i < static_cast<int>(distinct.size()) / 2; i++)
+            {
+                dynamic_hull.erase(distinct.back());
+                distinct.pop_back();
+            }
+            if (distinct.size() >= 3)
+            {
+                oracle_hull = ch::monotone_chain(distinct);
+                check("dynamic hull (erase)", dynamic_hull.hull());
+            }
+
+            // sliding window hull: the window holds the last third of the points
+            int window_size{ std::max(3, points_count / 3) };
+            ch::sliding_window_hull sliding_window_hull{};
+            for (int i{}; i < points_count; i++)
+            {
+                sliding_window_hull.push(points[i], static_cast<double>(i));
+                sliding_window_hull.expire_before(static_cast<double>(i - window_size + 1));
+            }
+            oracle_hull = ch::monotone_chain(std::vector<ch::v2>{ points.end() - std::min(window_size, points_count), points.end() });
+            check("sliding window hull", sliding_window_hull.hull());
+        }
+
+        if (mismatches.empty())
+        {
+            logger.log("hulls MATCH\n");
+        }
+        else
+        {
+            logger.log("hulls DON'T MATCH:");
+            for (const std::string& mismatch : mismatches)
+            {
+                logger.logf(" {};", mismatch);
+            }
+            logger.log("\n");
+        }
+    }
+}
+
+static void test_coordinate_types()
+{
+    Logger logger{};
+
+    logger.log("float and int32 coordinates against double\n");
+
+    std::random_device rd{};
+    std::uint64_t seed{ rd() };
+    logger.logf("seed: {}\n", seed);
+
+    // the hulls of float and int32 points must be the ones of the same points as doubles (they are all exactly representable)
+    auto to_double{ [](const auto& points)
+        {
+            std::vector<ch::v2> converted{};
+            for (auto p : points)
+            {
+                converted.emplace_back(static_cast<double>(p.x), static_cast<double>(p.y));
+            }
+            return converted;
+        } };
+
+    std::vector<std::pair<std::string, std::vector<ch::v2>>> datasets{};
+    for (ch::distribution d : ch::ALL_DISTRIBUTIONS)
+    {
+        datasets.emplace_back(ch::distribution_name(d), ch::generate_points(d, 100000, seed));
+    }
+
+    for (auto& [name, dataset] : datasets)
+    {
+        logger.log("--------------------------------------------------------------------------------\n");
+        logger.logf("{}\n", name);
+
+        std::vector<std::string> mismatches{};
+        auto check{ [&](const std::string& func_name, const std::vector<ch::v2>& truth, const std::vector<ch::v2>& hull)
+            {
+                if (!validate_hull(truth, hull))
+                {
+                    mismatches.emplace_back(func_name);
+                }
+            } };
+
+        std::vector<ch::v2f> floats{};
+        for (ch::v2 p : dataset)
+        {
+            floats.emplace_back(static_cast<float>(p.x), static_cast<float>(p.y));
+        }
+        std::vector<ch::v2> float_truth{ ch::monotone_chain(to_double(floats)) };
+        check("akl-toussaint (float)", float_truth, to_double(ch::akl_toussaint(floats)));
+        check("monotone chain (float)", float_truth, to_double(ch::monotone_chain(floats)));
+        check("quickhull (float)", float_truth, to_double(ch::quickhull(floats)));
+
+        // coordinates spread over most of the int32 range, so that differences and their products take up to 32 and 64 bits
+        std::vector<ch::v2i> integers{};
+        for (ch::v2 p : dataset)
+        {
+            integers.emplace_back(static_cast<std::int32_t>(std::lround(p.x * 2000.0 - 1e9)), static_cast<std::int32_t>(std::lround(p.y * 2000.0 - 1e9)));
+        }
+        std::vector<ch::v2> integer_truth{ ch::monotone_chain(to_double(integers)) };
+        ch::reset_hull_stats();
+        check("akl-toussaint (int32)", integer_truth, to_double(ch::akl_toussaint(integers)));
+        check("monotone chain (int32)", integer_truth, to_double(ch::monotone_chain(integers)));
+        check("quickhull (int32)", integer_truth, to_double(ch::quickhull(integers)));
+        if (ch::HULL_STATS_ENABLED && ch::get_hull_stats().orientation_fallbacks != 0)
+        {
+            mismatches.emplace_back("int32 predicates fell back to exact evaluation");
+        }
+
+        if (mismatches.empty())
+        {
+            logger.log("hulls MATCH\n");
+        }
+        else
+        {
+            logger.log("hulls DON'T MATCH:");
+            for (const std::string& mismatch : mismatches)
+            {
+                logger.logf(" {};", mismatch);
+            }
+            logger.log("\n");
+        }
+    }
+
+    // nearly collinear points at the ends of the int32 range: doubles can't hold the products of their differences
+    {
+        logger.log("--------------------------------------------------------------------------------\n");
+        logger.log("int32 extremes\n");
+
+        std::mt19937 gen{ static_cast<std::mt19937::result_type>(seed) };
+        std::uniform_int_distribution<int> step_distrib{ 0, 65000 };
+        std::uniform_int_distribution<int> offset_distrib{ -1, 1 };
+        std::vector<ch::v2i> integers{};
+        for (int i{}; i < 10000; i++)
+        {
+            std::int64_t step{ step_distrib(gen) };
+            std::int64_t x{ std::numeric_limits<std::int32_t>::min() + step * 65537 };
+            std::int64_t y{ std::numeric_limits<std::int32_t>::min() + step * 65535 + (i % 100 == 0 ? offset_distrib(gen) : 0) };
+            integers.emplace_back(static_cast<std::int32_t>(x), static_cast<std::int32_t>(std::max<std::int64_t>(y, std::numeric_limits<std::int32_t>::min())));
+        }
+
+        std::vector<ch::v2> truth{ ch::monotone_chain(to_double(integers)) };
+        bool ok{ validate_hull(truth, to_double(ch::akl_toussaint(integers))) };
+        ok = ok && validate_hull(truth, to_double(ch::monotone_chain(integers)));
+        ok = ok && validate_hull(truth, to_double(ch::quickhull(integers)));
+        logger.log(ok ? "hulls MATCH\n" : "hulls DON'T MATCH\n");
+    }
+}
+
+static void test_convex_hull_selection()
+{
+    Logger logger{};
+
+    logger.log("convex hull (automatic selection) against monotone chain\n");
+
+    std::random_device rd{};
+    std::uint64_t seed{ rd() };
+    logger.logf("seed: {}\n", seed);
+
+    for (ch::distribution d : ch::ALL_DISTRIBUTIONS)
+    {
+        logger.log("--------------------------------------------------------------------------------\n");
+        logger.logf("{}\n", ch::distribution_name(d));
+
+        // every engine, and both sides of every threshold of the selection table, are crossed on the way
+        std::vector<ch::v2> dataset{ ch::generate_points(d, 100000, seed) };
+        bool ok{ true };
+        for (int points_count{ 3 }; points_count <= static_cast<int>(dataset.size()); points_count = points_count * 3 / 2 + 1)
+        {
+            std::vector<ch::v2> points{ dataset.begin(), dataset.begin() + points_count };
+            ch::hull_engine engine{ ch::select_hull_engine(points) };
+            bool match{ validate_hull(ch::monotone_chain(points), ch::convex_hull(points)) };
+            logger.logf("{} points: {} {}\n", points_count, ch::hull_engine_name(engine), match ? "MATCH" : "DON'T MATCH");
+            ok = ok && match;
+        }
+        logger.log(ok ? "hulls MATCH\n" : "hulls DON'T MATCH\n");
+    }
+}
+
+static void test_point_set_against_points()
+{
+    Logger logger{};
+
+    logger.log("point set overloads against std::vector overloads\n");
+
+    int dataset_capacity{ 10000 };
+    logger.log("--------------------------------------------------------------------------------\n");
+    logger.logf("dataset capacity: {}\n", dataset_capacity);
+
+    std::vector<ch::v2> dataset{ generate_dataset(logger, dataset_capacity) };
+
+    std::random_device rd{};
+    std::mt19937 gen{ rd() };
+    std::uniform_int_distribution<> distrib{ 5, 100 };
+    int points_count{ distrib(gen) };
+    while (points_count < static_cast<int>(dataset.size()))
+    {
+        logger.log("--------------------------------------------------------------------------------\n");
+        logger.logf("points count: {}\n", points_count);
+
+        // copy portion of point dataset, in both layouts
+        std::vector<ch::v2> points{ dataset.begin(), dataset.begin() + points_count };
+        ch::point_set point_set{ points };
+
+        bool akl_toussaint_match{ validate_hull(ch::akl_toussaint(points), ch::akl_toussaint(point_set)) };
+        bool torch_match{ validate_hull(ch::torch(points), ch::torch(point_set)) };
+        bool dc_match{ validate_hull(ch::divide_and_conquer(points), ch::divide_and_conquer(point_set)) };
+        bool sample_match{ ch::sample_points_for_subset(points, points_count / 4 + 1) == ch::sample_points_for_subset(point_set, points_count / 4 + 1).to_points() };
+        if (akl_toussaint_match && torch_match && dc_match && sample_match)
+        {
+            logger.log("results MATCH\n");
+        }
+        else
+        {
+            logger.logf("results DON'T MATCH (akl-toussaint {}, torch {}, divide and conquer {}, sample {})\n", akl_toussaint_match, torch_match, dc_match, sample_match);
+        }
+
+        points_count += distrib(gen);
+    }
+}
+
+static void test_sample_points_for_subset()
+{
+    Logger logger{};
+
+    logger.log("test sample points for subset\n");
+
+    int dataset_capacity{ 10000 };
+    logger.log("--------------------------------------------------------------------------------\n");
+    logger.logf("dataset capacity: {}\n", dataset_capacity);
+
+    std::vector<ch::v2> dataset{ generate_dataset(logger, dataset_capacity) };
+
+    std::random_device rd{};
+    std::mt19937 gen{ rd() };
+    std::uniform_int_distribution<> points_count_increment_distrib{ 5, 100 };
+    int points_count{ points_count_increment_distrib(gen) };
+    while (points_count < static_cast<int>(dataset.size()))
+    {
+        std::uniform_int_distribution<> k_increment_distrib{ 1, points_count / 2 };
+        int k{ k_increment_distrib(gen) };
+        while (k < points_count)
+        {
+            logger.log("--------------------------------------------------------------------------------\n");
+            logger.logf("points count: {}\n", points_count);
+            logger.logf("k: {}\n", k);
+
+            // copy portion of point dataset
+            std::vector<ch::v2> points{ dataset.begin(), dataset.begin() + points_count };
+
+            logger.log("sampling ... ");
+            std::vector<ch::v2> points_sample{};
+            {
+                auto start{ std::chrono::high_resolution_clock::now() };
+                points_sample = ch::sample_points_for_subset(points, k);
+                auto end{ std::chrono::high_resolution_clock::now() };
+                auto us{ std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() };
+                logger.logf("DONE ... {} us\n", us);
+            }
+
+            logger.log("computing approximate convex hull ... ");
+            std::vector<ch::v2> approximate_hull{};
+            {
+                auto start{ std::chrono::high_resolution_clock::now() };
+                approximate_hull = ch::akl_toussaint(points_sample);
+                auto end{ std::chrono::high_resolution_clock::now() };
+                auto us{ std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() };
+                logger.logf("DONE ... {} us\n", us);
+            }
+
+            logger.log("computing correct convex hull ... ");
+            std::vector<ch::v2> hull{};
+            {
+                auto start{ std::chrono::high_resolution_clock::now() };
+                hull = ch::akl_toussaint(points);
+                auto end{ std::chrono::high_resolution_clock::now() };
+                auto us{ std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() };
+                logger.logf("DONE ... {} us\n", us);
+            }
+
+            if (validate_points_subset(points, points_sample, hull, approximate_hull))
+            {
+                logger.log("points sample is OK\n");
+            }
+            else
+            {
+                logger.log("points sample is WRONG\n");
+            }
+
+            k += k_increment_distrib(gen);
+        }
+
+        points_count += points_count_increment_distrib(gen);
+    }
+}
+
+/*
+    Times every (distribution, algorithm, n) point of the options: warmup runs first, then the timed repetitions, whose
+    summary statistics are logged and written to the CSV and JSON outputs. The operation counts and allocations are the
+    ones of the last repetition (they are the same for every run).
+    Points are prefixes of a single dataset per distribution, as large as the largest n (thus spread over its square,
+    rather than being the datasets of n points: see generate_points).
+*/
+static void benchmark(const ch::benchmark_options& options)
+{
+    Logger logger{};
+    logger.log("--------------------------------------------------------------------------------\n");
+    logger.log("Benchmark\n");
+
+    std::pair<const char*, HullFn> all_algorithms[]
+    {
+        { "naive", ch::naive },
+        { "divide_and_conquer", ch::divide_and_conquer },
+        { "divide_and_conquer_parallel", ch::divide_and_conquer_parallel },
+        { "akl_toussaint", ch::akl_toussaint },
+        { "torch", ch::torch },
+        { "monotone_chain", ch::monotone_chain },
+        { "quickhull", ch::quickhull },
+        { "chan", ch::chan },
+        { "kirkpatrick_seidel", ch::kirkpatrick_seidel },
+        { "naive_akl_toussaint", ch::naive_akl_toussaint },
+        { "divide_and_conquer_akl_toussaint", ch::divide_and_conquer_akl_toussaint },
+        { "torch_akl_toussaint", ch::torch_akl_toussaint },
+        { "kirkpatrick_seidel_akl_toussaint", ch::kirkpatrick_seidel_akl_toussaint },
+        { "convex_hull", [](const std::vector<ch::v2>& points) { return ch::convex_hull(points); } },
+    };
+    std::vector<std::pair<const char*, HullFn>> algorithms{};
+    for (auto [name, algorithm] : all_algorithms)
+    {
+        if (options.algorithms.empty() || std::find(options.algorithms.begin(), options.algorithms.end(), name) != options.algorithms.end())
+        {
+            algorithms.emplace_back(name, algorithm);
+        }
+    }
+    std::vector<ch::distribution> distributions{ options.distributions };
+    if (distributions.empty())
+    {
+        distributions.assign(std::begin(ch::ALL_DISTRIBUTIONS), std::end(ch::ALL_DISTRIBUTIONS));
+    }
+    std::vector<long long> sizes{ ch::benchmark_sizes(options) };
+
+    logger.log("--------------------------------------------------------------------------------\n");
+    logger.logf("n: {} points from {} to {}, warmup: {}, repetitions: {}\n", sizes.size(), sizes.front(), sizes.back(), options.warmup, options.repetitions);
+    logger.logf("kill zone kernel: {}, threads: {}\n", ch::kill_zone_kernel_name(), ch::thread_count());
+    if (!ch::HULL_STATS_ENABLED)
+    {
+        logger.log("hull stats: compiled out (build the Stats configuration, i.e. with CH_HULL_STATS=1, to count operations)\n");
+    }
+    else
+    {
+        logger.log("hull stats: counted, at a cost inside of orientation (time with the Release configuration instead)\n");
+    }
+
+    std::vector<ch::benchmark_record> records{};
+    for (ch::distribution distribution : distributions)
+    {
+        logger.log("--------------------------------------------------------------------------------\n");
+        logger.logf("distribution: {}\n", ch::distribution_name(distribution));
+
+        std::vector<ch::v2> dataset{ load_dataset(logger, distribution, static_cast<int>(sizes.back()), options.seed) };
+
+        for (auto [name, algorithm] : algorithms)
+        {
+            logger.log("--------------------------------------------------------------------------------\n");
+            logger.logf("{}\n", name);
+
+            double elapsed_seconds{};
+            double previous_median_ns{}, last_median_ns{};
+            long long previous_n{}, last_n{};
+            for (long long n : sizes)
+            {
+                /*
+                    Skip the remaining points once they are bound to exceed the budget. The time is extrapolated from the last
+                    point as n^k, with k the growth exponent between the last two points: at least 1, the time grows at least
+                    linearly with n (a linear guess would underestimate the quadratic and cubic algorithms by far).
+                */
+                int runs{ options.warmup + options.repetitions };
+                double exponent{ 1.0 };
+                if (previous_n != 0 && previous_n < last_n && previous_median_ns > 0.0 && last_median_ns > 0.0)
+                {
+                    exponent = std::max(1.0, std::log(last_median_ns / previous_median_ns) / std::log(static_cast<double>(last_n) / static_cast<double>(previous_n)));
+                }
+                double predicted_seconds{ last_n == 0 ? 0.0 : last_median_ns * 1e-9 * std::pow(static_cast<double>(n) / static_cast<double>(last_n), exponent) * runs };
+                if (elapsed_seconds + predicted_seconds > options.budget_seconds)
+                {
+                    logger.logf("n={} and larger skipped: over the budget of {} s\n", n, options.budget_seconds);
+                    break;
+                }
+
+                // copy portion of point dataset
+                std::vector<ch::v2> points{ dataset.begin(), dataset.begin() + n };
+
+                std::vector<double> samples_ns{};
+                ch::benchmark_record record{ name, ch::distribution_name(distribution), n, options.repetitions };
+                for (int run{}; run < runs; run++)
+                {
+                    // run benchmark /w timing, allocation and operation counts
+                    ch::reset_hull_stats();
+                    long long allocations_before{ g_allocations_count.load() };
+                    auto start{ std::chrono::high_resolution_clock::now() };
+                    std::vector<ch::v2> hull{ algorithm(points) };
+                    auto end{ std::chrono::high_resolution_clock::now() };
+                    record.allocations = g_allocations_count.load() - allocations_before;
+                    record.stats = ch::get_hull_stats();
+                    record.hull_size = static_cast<long long>(hull.size());
+
+                    elapsed_seconds += std::chrono::duration<double>(end - start).count();
+                    if (run >= options.warmup)
+                    {
+                        samples_ns.emplace_back(std::chrono::duration<double, std::nano>(end - start).count());
+                    }
+                }
+                record.timings = ch::summarize_timings(samples_ns);
+                record.ns_per_point = record.timings.median_ns / static_cast<double>(n);
+                records.emplace_back(record);
+                previous_median_ns = last_median_ns;
+                previous_n = last_n;
+                last_median_ns = record.timings.median_ns;
+                last_n = n;
+
+                // print benchmark data point, in microseconds. fallbacks is the share of orientations that needed exact arithmetic
+                logger.logf(
+                    "n={} min={:.1f} median={:.1f} p95={:.1f} stddev={:.1f} ns/point={:.2f} allocs={}",
+                    n, record.timings.min_ns / 1000.0, record.timings.median_ns / 1000.0, record.timings.p95_ns / 1000.0, record.timings.stddev_ns / 1000.0,
+                    record.ns_per_point, record.allocations
+                );
+                if (ch::HULL_STATS_ENABLED)
+                {
+                    const ch::hull_stats& stats{ record.stats };
+                    double fallbacks{ stats.orientations == 0 ? 0.0 : 100.0 * static_cast<double>(stats.orientation_fallbacks) / static_cast<double>(stats.orientations) };
+                    logger.logf(
+                        " orientations={} fallbacks={:.2f}% discarded={} survivors={} tangent_steps={} deletions={} restarts={}",
+                        stats.orientations, fallbacks, stats.kill_zone_discarded, stats.kill_zone_survivors,
+                        stats.merge_tangent_steps, stats.convexify_deletions, stats.convexify_restarts
+                    );
+                }
+                logger.log("\n");
+            }
+        }
+    }
+
+    std::string error{};
+    if (!options.csv_path.empty())
+    {
+        logger.log(ch::write_benchmark_csv(options.csv_path, records, &error) ? std::format("results written to {}\n", options.csv_path) : error + "\n");
+    }
+    if (!options.json_path.empty())
+    {
+        logger.log(ch::write_benchmark_json(options.json_path, records, &error) ? std::format("results written to {}\n", options.json_path) : error + "\n");
+    }
+}
+
+// sweeps the base case size of divide and conquer, to find the best one for the machine at hand
+static void benchmark_divide_and_conquer_base_case()
+{
+    Logger logger{};
+    logger.log("--------------------------------------------------------------------------------\n");
+    logger.log("Benchmark divide and conquer base case size\n");
+
+    int dataset_capacity{ 1000000 };
+    logger.log("--------------------------------------------------------------------------------\n");
+    logger.logf("dataset capacity: {}\n", dataset_capacity);
+
+    constexpr std::uint64_t BENCHMARK_SEED{ 1 };
+    std::vector<ch::v2> dataset{ load_dataset(logger, ch::distribution::square, dataset_capacity, BENCHMARK_SEED) };
+
+    for (int base_case_size{ 1 }; base_case_size <= ch::DIVIDE_AND_CONQUER_MAX_BASE_CASE_SIZE; base_case_size++)
+    {
+        logger.log("--------------------------------------------------------------------------------\n");
+        logger.logf("base case size: {}\n", base_case_size);
+
+        for (int points_count{ 1000 }; points_count <= dataset_capacity; points_count *= 10)
+        {
+            // copy portion of point dataset
+            std::vector<ch::v2> points{ dataset.begin(), dataset.begin() + points_count };
+
+            // take the best of a few runs, to filter out noise
+            constexpr int RUNS{ 5 };
+            long long best_us{ std::numeric_limits<long long>::max() };
+            for (int run{}; run < RUNS; run++)
+            {
+                auto start{ std::chrono::high_resolution_clock::now() };
+                std::vector<ch::v2> hull{ ch::divide_and_conquer_with_base_case(points, base_case_size) };
+                auto end{ std::chrono::high_resolution_clock::now() };
+                best_us = std::min(best_us, static_cast<long long>(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count()));
+            }
+
+            logger.logf("n={} t={}\n", points_count, best_us);
+        }
+    }
+}
+
+static void benchmark_dynamic_hull()
+{
+    Logger logger{};
+    logger.log("--------------------------------------------------------------------------------\n");
+    logger.log("Benchmark dynamic hull against recomputing torch akl-toussaint after every update\n");
+
+    int dataset_capacity{ 1000000 };
+    logger.log("--------------------------------------------------------------------------------\n");
+    logger.logf("dataset capacity: {}\n", dataset_capacity);
+
+    constexpr std::uint64_t BENCHMARK_SEED{ 1 };
+    std::vector<ch::v2> dataset{ load_dataset(logger, ch::distribution::square, dataset_capacity, BENCHMARK_SEED) };
+
+    constexpr int UPDATES{ 1000 };
+    for (int points_count{ 1000 }; points_count + UPDATES <= dataset_capacity && points_count <= 100000; points_count *= 10)
+    {
+        // mixed trace: every update either inserts the next point of the dataset or erases a random one
+        std::mt19937 gen{ static_cast<std::mt19937::result_type>(BENCHMARK_SEED) };
+        std::vector<ch::v2> points{ dataset.begin(), dataset.begin() + points_count };
+        ch::dynamic_hull dynamic_hull{};
+        for (ch::v2 p : points)
+        {
+            dynamic_hull.insert(p);
+        }
+
+        std::chrono::nanoseconds dynamic_time{};
+        std::chrono::nanoseconds recompute_time{};
+        std::size_t hull_sizes{}; // keeps the hulls from being optimized away
+        int next{ points_count };
+        for (int update{}; update < UPDATES; update++)
+        {
+            bool insert{ gen() % 2 == 0 };
+            int erased{ std::uniform_int_distribution<>{ 0, static_cast<int>(points.size()) - 1 }(gen) };
+            ch::v2 p{ insert ? dataset[next++] : points[erased] };
+
+            auto start{ std::chrono::high_resolution_clock::now() };
+            if (insert)
+            {
+                dynamic_hull.insert(p);
+            }
+            else
+            {
+                dynamic_hull.erase(p);
+            }
+            hull_sizes += dynamic_hull.hull().size();
+            auto middle{ std::chrono::high_resolution_clock::now() };
+            if (insert)
+            {
+                points.emplace_back(p);
+            }
+            else
+            {
+                points[erased] = points.back();
+                points.pop_back();
+            }
+            hull_sizes += ch::torch_akl_toussaint(points).size();
+            auto end{ std::chrono::high_resolution_clock::now() };
+
+            dynamic_time += middle - start;
+            recompute_time += end - middle;
+        }
+
+        long long dynamic_us{ std::chrono::duration_cast<std::chrono::microseconds>(dynamic_time).count() };
+        long long recompute_us{ std::chrono::duration_cast<std::chrono::microseconds>(recompute_time).count() };
+        logger.logf("n={} updates={} dynamic={} recompute={} (hull sizes {})\n", points_count, UPDATES, dynamic_us, recompute_us, hull_sizes);
+    }
+}
+
+static void benchmark_sliding_window_hull()
+{
+    Logger logger{};
+    logger.log("--------------------------------------------------------------------------------\n");
+    logger.log("Benchmark sliding window hull against recomputing akl-toussaint on every window\n");
+
+    int dataset_capacity{ 1000000 };
+    logger.log("--------------------------------------------------------------------------------\n");
+    logger.logf("dataset capacity: {}\n", dataset_capacity);
+
+    constexpr std::uint64_t BENCHMARK_SEED{ 1 };
+    std::vector<ch::v2> dataset{ load_dataset(logger, ch::distribution::square, dataset_capacity, BENCHMARK_SEED) };
+
+    constexpr int TICKS{ 1000 };
+    for (int window_size{ 1000 }; window_size + TICKS <= dataset_capacity && window_size <= 100000; window_size *= 10)
+    {
+        // fill the window, then every tick pushes a point, expires the oldest one and reports the hull
+        ch::sliding_window_hull sliding_window_hull{};
+        for (int i{}; i < window_size; i++)
+        {
+            sliding_window_hull.push(dataset[i]);
+        }
+
+        std::size_t hull_sizes{}; // keeps the hulls from being optimized away
+        auto start{ std::chrono::high_resolution_clock::now() };
+        for (int tick{}; tick < TICKS; tick++)
+        {
+            sliding_window_hull.push(dataset[window_size + tick]);
+            sliding_window_hull.expire();
+            hull_sizes += sliding_window_hull.hull().size();
+        }
+        auto middle{ std::chrono::high_resolution_clock::now() };
+        for (int tick{}; tick < TICKS; tick++)
+        {
+            std::vector<ch::v2> window{ dataset.begin() + tick + 1, dataset.begin() + window_size + tick + 1 };
+            hull_sizes += ch::akl_toussaint(window).size();
+        }
+        auto end{ std::chrono::high_resolution_clock::now() };
+
+        long long sliding_us{ std::chrono::duration_cast<std::chrono::microseconds>(middle - start).count() };
+        long long recompute_us{ std::chrono::duration_cast<std::chrono::microseconds>(end - middle).count() };
+        logger.logf("w={} ticks={} sliding={} recompute={} (hull sizes {})\n", window_size, TICKS, sliding_us, recompute_us, hull_sizes);
+    }
+}
+
+static void benchmark_batch_hulls()
+{
+    Logger logger{};
+    logger.log("--------------------------------------------------------------------------------\n");
+    logger.log("Benchmark batch hulls against one akl-toussaint call per group\n");
+
+    int dataset_capacity{ 10000000 };
+    logger.log("--------------------------------------------------------------------------------\n");
+    logger.logf("dataset capacity: {}\n", dataset_capacity);
+
+    constexpr std::uint64_t BENCHMARK_SEED{ 1 };
+    std::vector<ch::v2> dataset{ load_dataset(logger, ch::distribution::square, dataset_capacity, BENCHMARK_SEED) };
+    logger.logf("threads: {}\n", ch::thread_count());
+
+    for (int group_size : { 5, 20, 200 })
+    {
+        std::vector<int> offsets{};
+        for (int offset{}; offset <= dataset_capacity; offset += group_size)
+        {
+            offsets.emplace_back(offset);
+        }
+        int points_count{ offsets.back() };
+
+        std::size_t hull_sizes{}; // keeps the hulls from being optimized away
+        auto start{ std::chrono::high_resolution_clock::now() };
+        ch::point_groups hulls{ ch::batch_hulls(std::span<const ch::v2>{ dataset.data(), static_cast<std::size_t>(points_count) }, offsets) };
+        hull_sizes += hulls.points.size();
+        auto middle{ std::chrono::high_resolution_clock::now() };
+        for (int i{}; i + 1 < static_cast<int>(offsets.size()); i++)
+        {
+            std::vector<ch::v2> group{ dataset.begin() + offsets[i], dataset.begin() + offsets[i + 1] };
+            hull_sizes += ch::akl_toussaint(group).size();
+        }
+        auto end{ std::chrono::high_resolution_clock::now() };
+
+        long long batch_ms{ std::chrono::duration_cast<std::chrono::milliseconds>(middle - start).count() };
+        long long single_ms{ std::chrono::duration_cast<std::chrono::milliseconds>(end - middle).count() };
+        logger.logf("group size={} groups={} batch={}ms single={}ms (hull sizes {})\n", group_size, offsets.size() - 1, batch_ms, single_ms, hull_sizes);
+    }
+}
+
+static void benchmark_streaming_hull()
+{
+    Logger logger{};
+    logger.log("--------------------------------------------------------------------------------\n");
+    logger.log("Benchmark streaming hull of a text point file\n");
+
+    int dataset_capacity{ 10000000 };
+    logger.log("--------------------------------------------------------------------------------\n");
+    logger.logf("dataset capacity: {}\n", dataset_capacity);
+
+    constexpr std::uint64_t BENCHMARK_SEED{ 1 };
+    std::vector<ch::v2> dataset{ load_dataset(logger, ch::distribution::square, dataset_capacity, BENCHMARK_SEED) };
+
+    // write the dataset in the text format, with enough digits to read back the same doubles
+    std::string path{ "streaming.txt" };
+    {
+        logger.logf("writing {} ... ", path);
+        std::ofstream out_file{ path };
+        out_file << std::setprecision(17) << dataset.size() << "\n";
+        for (ch::v2 p : dataset)
+        {
+            out_file << p.x << " " << p.y << "\n";
+        }
+        logger.log("DONE\n");
+    }
+
+    std::vector<ch::v2> truth{ ch::akl_toussaint(dataset) };
+    for (int chunk_size{ 1 << 16 }; chunk_size <= (1 << 22); chunk_size *= 4)
+    {
+        ch::streaming_hull_result result{ ch::streaming_hull(path, chunk_size) };
+        if (!result.error.empty())
+        {
+            logger.logf("chunk={} error: {}\n", chunk_size, result.error);
+            continue;
+        }
+        logger.logf("chunk={} n={} t={:.3f}s throughput={:.0f} points/s hull {}\n",
+            chunk_size, result.points_count, result.seconds, result.points_per_second,
+            validate_hull(truth, result.hull) ? "MATCH" : "DON'T MATCH");
+    }
+}
+
+static void benchmark_traces()
+{
+    Logger logger{};
+    logger.log("--------------------------------------------------------------------------------\n");
+    logger.log("Trace the phases of the algorithms (open the trace files in chrome://tracing or ui.perfetto.dev)\n");
+
+    int dataset_capacity{ 10000000 };
+    logger.log("--------------------------------------------------------------------------------\n");
+    logger.logf("dataset capacity: {}\n", dataset_capacity);
+
+    constexpr std::uint64_t BENCHMARK_SEED{ 1 };
+    std::vector<ch::v2> dataset{ load_dataset(logger, ch::distribution::disk, dataset_capacity, BENCHMARK_SEED) };
+
+    std::pair<const char*, HullFn> algorithms[]
+    {
+        { "akl_toussaint", ch::akl_toussaint },
+        { "quickhull", ch::quickhull },
+        { "torch_akl_toussaint", ch::torch_akl_toussaint },
+        { "divide_and_conquer_parallel", ch::divide_and_conquer_parallel },
+        { "monotone_chain", ch::monotone_chain },
+    };
+    for (auto [name, algorithm] : algorithms)
+    {
+        ch::start_tracing();
+        auto start{ std::chrono::high_resolution_clock::now() };
+        std::vector<ch::v2> hull{ algorithm(dataset) };
+        auto end{ std::chrono::high_resolution_clock::now() };
+        ch::stop_tracing();
+
+        std::string path{ std::format("trace_{}.json", name) };
+        std::string error{};
+        if (ch::write_chrome_trace(path, &error))
+        {
+            logger.logf("{}: t={} trace written to {}\n", name, format_duration(end - start), path);
+        }
+        else
+        {
+            logger.logf("{}: {}\n", name, error);
+        }
+    }
+}
+
+static void benchmark_point_files()
+{
+    Logger logger{};
+    logger.log("--------------------------------------------------------------------------------\n");
+    logger.log("Benchmark text against memory mapped binary point files\n");
+
+    int dataset_capacity{ 10000000 };
+    logger.log("--------------------------------------------------------------------------------\n");
+    logger.logf("dataset capacity: {}\n", dataset_capacity);
+
+    constexpr std::uint64_t BENCHMARK_SEED{ 1 };
+    std::vector<ch::v2> dataset{ load_dataset(logger, ch::distribution::square, dataset_capacity, BENCHMARK_SEED) };
+    std::vector<ch::v2> truth{ ch::akl_toussaint(dataset) };
+
+    std::string text_path{ "points.txt" };
+    {
+        std::ofstream out_file{ text_path };
+        out_file << std::setprecision(17) << dataset.size() << "\n";
+        for (ch::v2 p : dataset)
+        {
+            out_file << p.x << " " << p.y << "\n";
+        }
+    }
+
+    // text: parse all the points, then run the algorithm
+    {
+        auto start{ std::chrono::high_resolution_clock::now() };
+        ch::text_parse_result parsed{ ch::parse_text_points(text_path) };
+        auto middle{ std::chrono::high_resolution_clock::now() };
+        std::vector<ch::v2> hull{ parsed.error.empty() ? ch::akl_toussaint(parsed.points) : std::vector<ch::v2>{} };
+        auto end{ std::chrono::high_resolution_clock::now() };
+        logger.logf("text: load={} hull={} {}\n", format_duration(middle - start), format_duration(end - middle), validate_hull(truth, hull) ? "MATCH" : "DON'T MATCH");
+    }
+
+    // binary: map the file, then run the algorithm straight on the mapped coordinates
+    for (ch::point_layout layout : { ch::point_layout::aos, ch::point_layout::soa })
+    {
+        bool aos{ layout == ch::point_layout::aos };
+        std::string binary_path{ aos ? "points_aos.bin" : "points_soa.bin" };
+        std::string error{};
+        if (!ch::convert_text_to_binary(text_path, binary_path, ch::coordinate_type::f64, layout, &error))
+        {
+            logger.logf("conversion failed: {}\n", error);
+            continue;
+        }
+
+        auto start{ std::chrono::high_resolution_clock::now() };
+        ch::mapped_point_file file{ binary_path };
+        auto middle{ std::chrono::high_resolution_clock::now() };
+        std::vector<ch::v2> hull{};
+        if (file.is_open())
+        {
+            hull = aos ? ch::akl_toussaint(file.points()) : ch::akl_toussaint(file.xs(), file.ys());
+        }
+        auto end{ std::chrono::high_resolution_clock::now() };
+        logger.logf("binary {}: load={} hull={} {}\n", aos ? "aos" : "soa", format_duration(middle - start), format_duration(end - middle), validate_hull(truth, hull) ? "MATCH" : "DON'T MATCH");
+    }
+}
+
+static void benchmark_text_parsing()
+{
+    Logger logger{};
+    logger.log("--------------------------------------------------------------------------------\n");
+    logger.log("Benchmark text point file parsing\n");
+
+    int dataset_capacity{ 10000000 };
+    logger.log("--------------------------------------------------------------------------------\n");
+    logger.logf("dataset capacity: {}\n", dataset_capacity);
+
+    constexpr std::uint64_t BENCHMARK_SEED{ 1 };
+    std::vector<ch::v2> dataset{ load_dataset(logger, ch::distribution::square, dataset_capacity, BENCHMARK_SEED) };
+
+    std::string path{ "points.txt" };
+    {
+        std::ofstream out_file{ path };
+        out_file << std::setprecision(17) << dataset.size() << "\n";
+        for (ch::v2 p : dataset)
+        {
+            out_file << p.x << " " << p.y << "\n";
+        }
+    }
+    double megabytes{ static_cast<double>(std::filesystem::file_size(path)) / 1e6 };
+    logger.logf("file size: {:.1f} MB\n", megabytes);
+
+    // iostream, as the text files have always been read
+    {
+        auto start{ std::chrono::high_resolution_clock::now() };
+        std::ifstream in_file{ path };
+        int count{};
+        in_file >> count;
+        std::vector<ch::v2> points(count);
+        for (ch::v2& p : points)
+        {
+            in_file >> p.x >> p.y;
+        }
+        auto end{ std::chrono::high_resolution_clock::now() };
+        double seconds{ std::chrono::duration<double>(end - start).count() };
+        logger.logf("iostream: t={:.3f}s {:.0f} MB/s {}\n", seconds, megabytes / seconds, points == dataset ? "MATCH" : "DON'T MATCH");
+    }
+
+    // from_chars, one buffer at a time on a single thread
+    {
+        auto start{ std::chrono::high_resolution_clock::now() };
+        ch::text_point_reader reader{ path };
+        std::vector<ch::v2> points{};
+        reader.read(points, std::numeric_limits<int>::max());
+        auto end{ std::chrono::high_resolution_clock::now() };
+        double seconds{ std::chrono::duration<double>(end - start).count() };
+        logger.logf("text_point_reader: t={:.3f}s {:.0f} MB/s {}\n", seconds, megabytes / seconds, points == dataset ? "MATCH" : "DON'T MATCH");
+    }
+
+    // from_chars, newline aligned chunks in parallel
+    {
+        ch::text_parse_result result{ ch::parse_text_points(path) };
+        if (result.error.empty())
+        {
+            logger.logf("parse_text_points ({} threads): t={:.3f}s {:.0f} MB/s {}\n", ch::thread_count(), result.seconds, result.megabytes_per_second, result.points == dataset ? "MATCH" : "DON'T MATCH");
+        }
+        else
+        {
+            logger.logf("parse_text_points error: {}\n", result.error);
+        }
+    }
+}
+
+#if 0
+int main()
+{
+    // generate points
+    int points_count{ 500 };
+    std::vector<ch::v2> points{ ch::generate_points(ch::distribution::square, points_count, 1) };
+    assert(points.size() == points_count); // sanity check
+
+    // generate hull and test against oracle
+    //std::vector<ch::v2> naive_hull{ ch::naive(points) };
+    //std::vector<ch::v2> dc_hull{ ch::divide_and_conquer(points) };
+    #if 1
+    std::vector<ch::v2> akl_toussaint_hull{ ch::akl_toussaint(points) };
+    std::vector<ch::v2> torch_hull{ ch::torch(points) };
+    dump_points_and_hull(points, torch_hull);
+    #else
+    std::vector<ch::v2> sampled_points{ ch::sample_points_for_subset(points, 9) };
+    dump_points_and_hull(sampled_points, {});
+    #endif
+
+    #if 1
+    if (!validate_hull(akl_toussaint_hull, torch_hull))
+    {
+        std::cerr << "hull validation failed" << std::endl;
+        return -1;
+    }
+    #endif
+
+    return 0;
+}
+#else
+int main(int argc, char** argv)
+{
+    // $ ConvexHull convert <text file> <binary file> [f32] [soa]
+    if (argc >= 4 && std::string{ argv[1] } == "convert")
+    {
+        ch::coordinate_type type{ ch::coordinate_type::f64 };
+        ch::point_layout layout{ ch::point_layout::aos };
+        for (int i{ 4 }; i < argc; i++)
+        {
+            std::string option{ argv[i] };
+            if (option == "f32")
+            {
+                type = ch::coordinate_type::f32;
+            }
+            else if (option == "soa")
+            {
+                layout = ch::point_layout::soa;
+            }
+        }
+
+        std::string error{};
+        if (!ch::convert_text_to_binary(argv[2], argv[3], type, layout, &error))
+        {
+            std::cerr << "conversion failed: " << error << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    // $ ConvexHull benchmark [--algorithms a,b] [--distributions d,e] [--n min:max:step | min:max:xgrowth] [--warmup w] [--repetitions r] ...
+    // (see ch::parse_benchmark_options)
+    if (argc >= 2 && std::string{ argv[1] } == "benchmark")
+    {
+        ch::benchmark_options options{};
+        std::string error{};
+        if (!ch::parse_benchmark_options(argc - 2, argv + 2, options, &error))
+        {
+            std::cerr << "benchmark: " << error << std::endl;
+            return 1;
+        }
+        benchmark(options);
+        return 0;
+    }
+
+    //test_akl_toussaint_against_dc();
+    //test_torch_against_akl_toussaint();
+    //test_naive_akl_toussaint_against_naive();
+    //test_dc_akl_toussaint_against_dc();
+    //test_dc_parallel_against_dc();
+    //test_torch_akl_toussaint_against_torch();
+    //test_monotone_chain_against_dc();
+    //test_quickhull_against_akl_toussaint();
+    //test_chan_against_akl_toussaint();
+    //test_kirkpatrick_seidel_against_akl_toussaint();
+    //test_incremental_hull_against_akl_toussaint();
+    //test_dynamic_hull_against_akl_toussaint();
+    //test_sliding_window_hull_against_akl_toussaint();
+    //test_batch_hulls_against_monotone_chain();
+    //test_degenerate_inputs();
+    //test_coordinate_types();
+    //test_convex_hull_selection();
+    //test_point_set_against_points();
+
+    //test_sample_points_for_subset();
+
+    //benchmark_divide_and_conquer_base_case();
+    //benchmark_dynamic_hull();
+    //benchmark_sliding_window_hull();
+    //benchmark_batch_hulls();
+    //benchmark_streaming_hull();
+    //benchmark_point_files();
+    //benchmark_traces();
+    //benchmark_text_parsing();
+    benchmark(ch::benchmark_options{});
+    return 0;
 }
 #endif
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <ConvexHull.h>
+#include <HullStats.h>
+#include <Predicates.h>
+
+namespace ch
+{
+    /*
+        Andrew's monotone chain over sorted[0, count), which must be in lexicographic order and not all the same point.
+        Writes to chain (which must have room for 2 * count points) the clockwise hull, from the leftmost point, without
+        collinear points and duplicates, and returns its size. Shared by monotone_chain and scratch_hull.
+    */
+    template<typename T>
+    int monotone_chain_sorted(const basic_v2<T>* sorted, int count, basic_v2<T>* chain)
+    {
+        // upper chain from left to right and lower chain from right to left, both clockwise
+        int size{};
+        int restarts{};
+        for (int i{}; i < count; i++)
+        {
+            int size_before{ size };
+            while (size >= 2 && orientation(chain[size - 2], chain[size - 1], sorted[i]) >= 0)
+            {
+                size--; // not a right turn
+            }
+            restarts += size != size_before;
+            chain[size++] = sorted[i];
+        }
+        int upper_size{ size };
+        for (int i{ count - 2 }; i >= 0; i--)
+        {
+            int size_before{ size };
+            while (size > upper_size && orientation(chain[size - 2], chain[size - 1], sorted[i]) >= 0)
+            {
+                size--; // not a right turn
+            }
+            restarts += size != size_before;
+            chain[size++] = sorted[i];
+        }
+        // both chains push every point but the rightmost one once more: whatever isn't left was deleted
+        count_hull_stat(hull_counter::convexify_deletions, 2 * count - 1 - size);
+        count_hull_stat(hull_counter::convexify_restarts, restarts);
+        return size - 1; // the last point is the leftmost one, which is already the first one
+    }
+}
@@ -0,0 +1,261 @@
+#include <Parallel.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ch
+{
+    namespace
+    {
+        struct task
+        {
+            const std::function<void()>* fn{};
+            std::atomic<bool> done{ false };
+        };
+
+        // double ended queue of tasks: the owner pushes and pops at the back, thieves steal from the front
+        class task_deque
+        {
+        public:
+            void push(task* t)
+            {
+                std::lock_guard<std::mutex> lock{ m_mutex };
+                m_tasks.emplace_back(t);
+            }
+            bool pop_if_back(task* t)
+            {
+                std::lock_guard<std::mutex> lock{ m_mutex };
+                if (!m_tasks.empty() && m_tasks.back() == t)
+                {
+                    m_tasks.pop_back();
+                    return true;
+                }
+                return false;
+            }
+            task* pop()
+            {
+                std::lock_guard<std::mutex> lock{ m_mutex };
+                if (m_tasks.empty()) return nullptr;
+                task* t{ m_tasks.back() };
+                m_tasks.pop_back();
+                return t;
+            }
+            task* steal()
+            {
+                std::lock_guard<std::mutex> lock{ m_mutex };
+                if (m_tasks.empty()) return nullptr;
+                task* t{ m_tasks.front() };
+                m_tasks.pop_front();
+                return t;
+            }
+        private:
+            std::mutex m_mutex;
+            std::deque<task*> m_tasks;
+        };
+
+        // index of the deque owned by the current thread (workers only)
+        thread_local int t_deque_idx{ -1 };
+
+        class task_pool
+        {
+        public:
+            static task_pool& instance()
+            {
+                static task_pool pool{ thread_count() - 1 };
+                return pool;
+            }
+        public:
+            task_pool(int workers_count);
+            ~task_pool();
+            task_pool(const task_pool&) = delete;
+            task_pool(task_pool&&) noexcept = delete;
+            task_pool& operator=(const task_pool&) = delete;
+            task_pool& operator=(task_pool&&) noexcept = delete;
+        public:
+            void fork_join(const std::function<void()>& a, const std::function<void()>& b);
+        private:
+            void worker_loop(int idx);
+            bool try_run_one(int idx);
+            static void run(task* t);
+        private:
+            // one deque for each worker, plus one shared by all the threads that are not workers (the last one)
+            std::vector<std::unique_ptr<task_deque>> m_deques;
+            std::vector<std::thread> m_workers;
+            std::atomic<int> m_pending;
+            std::atomic<bool> m_stop;
+            std::mutex m_sleep_mutex;
+            std::condition_variable m_sleep_cv;
+        };
+
+        task_pool::task_pool(int workers_count)
+            : m_deques{}
+            , m_workers{}
+            , m_pending{}
+            , m_stop{}
+            , m_sleep_mutex{}
+            , m_sleep_cv{}
+        {
+            for (int i{}; i < workers_count + 1; i++)
+            {
+                m_deques.emplace_back(std::make_unique<task_deque>());
+            }
+            for (int i{}; i < workers_count; i++)
+            {
+                m_workers.emplace_back(&task_pool::worker_loop, this, i);
+            }
+        }
+        task_pool::~task_pool()
+        {
+            {
+                std::lock_guard<std::mutex> lock{ m_sleep_mutex };
+                m_stop = true;
+            }
+            m_sleep_cv.notify_all();
+            for (std::thread& worker : m_workers)
+            {
+                worker.join();
+            }
+        }
+        void task_pool::fork_join(const std::function<void()>& a, const std::function<void()>& b)
+        {
+            if (m_workers.empty())
+            {
+                a();
+                b();
+                return;
+            }
+
+            int idx{ t_deque_idx >= 0 ? t_deque_idx : static_cast<int>(m_deques.size()) - 1 };
+
+            // make b available to thieves
+            task tb{};
+            tb.fn = &b;
+            m_deques[idx]->push(&tb);
+            {
+                std::lock_guard<std::mutex> lock{ m_sleep_mutex };
+                m_pending++;
+            }
+            m_sleep_cv.notify_one();
+
+            a();
+
+            if (m_deques[idx]->pop_if_back(&tb))
+            {
+                // nobody stole b
+                m_pending--;
+                b();
+            }
+            else
+            {
+                // b was stolen: help the others while waiting for it
+                while (!tb.done.load(std::memory_order_acquire))
+                {
+                    if (!try_run_one(idx))
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            }
+        }
+        void task_pool::worker_loop(int idx)
+        {
+            t_deque_idx = idx;
+            while (true)
+            {
+                if (try_run_one(idx))
+                {
+                    continue;
+                }
+
+                std::unique_lock<std::mutex> lock{ m_sleep_mutex };
+                m_sleep_cv.wait(lock, [this]() { return m_stop || m_pending > 0; });
+                if (m_stop)
+                {
+                    break;
+                }
+            }
+        }
+        bool task_pool::try_run_one(int idx)
+        {
+            // first, our own work (most recent first)
+            task* t{ m_deques[idx]->pop() };
+
+            // then, other threads' work (oldest first, i.e. the biggest chunks of work)
+            int deques_count{ static_cast<int>(m_deques.size()) };
+            for (int i{ 1 }; i < deques_count && !t; i++)
+            {
+                t = m_deques[(idx + i) % deques_count]->steal();
+            }
+
+            if (t)
+            {
+                m_pending--;
+                run(t);
+                return true;
+            }
+            else
+            {
+                return false;
+            }
+        }
+        void task_pool::run(task* t)
+        {
+            (*t->fn)();
+            t->done.store(true, std::memory_order_release);
+        }
+
+        void parallel_for_impl(int begin, int end, int grain, const std::function<void(int, int)>& fn)
+        {
+            if (end - begin <= grain)
+            {
+                fn(begin, end);
+            }
+            else
+            {
+                int middle{ begin + (end - begin) / 2 };
+                fork_join(
+                    [&]() { parallel_for_impl(begin, middle, grain, fn); },
+                    [&]() { parallel_for_impl(middle, end, grain, fn); }
+                );
+            }
+        }
+    }
+
+    int thread_count()
+    {
+        static const int count{ []()
+            {
+                if (const char* env{ std::getenv("CH_THREADS") }; env && std::atoi(env) > 0)
+                {
+                    return std::atoi(env);
+                }
+                // hardware_concurrency is allowed to return 0 when the value is not computable
+                return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+            }() };
+        return count;
+    }
+
+    void fork_join(const std::function<void()>& a, const std::function<void()>& b)
+    {
+        task_pool::instance().fork_join(a, b);
+    }
+
+    void parallel_for(int count, const std::function<void(int, int)>& fn)
+    {
+        if (count <= 0)
+        {
+            return;
+        }
+
+        // a few chunks for each thread, so that threads that are done early can steal the remaining ones
+        int grain{ std::max(1, count / (thread_count() * 4)) };
+        parallel_for_impl(0, count, grain, fn);
+    }
+}
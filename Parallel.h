@@ -0,0 +1,44 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+
+namespace ch
+{
+    /*
+        Returns the number of threads the parallel routines spread their work on (at least one).
+        It defaults to the number of hardware threads and can be overridden by the CH_THREADS environment variable.
+    */
+    int thread_count();
+
+    /*
+        Runs a and b, possibly in parallel, and returns when both are done.
+        b is pushed on the work-stealing deque of the calling thread while it runs a: if no idle thread stole b in the
+        meantime, the calling thread runs b as well. Otherwise, it helps with other pending tasks until b is done.
+        fork_join calls can be nested arbitrarily deep.
+    */
+    void fork_join(const std::function<void()>& a, const std::function<void()>& b);
+
+    // splits [0, count) in contiguous chunks and runs fn(begin, end) on every chunk, in parallel.
+    // returns when all the chunks have been processed.
+    void parallel_for(int count, const std::function<void(int, int)>& fn);
+
+    // parallel merge sort: the two halves are sorted in parallel and then merged, down to cutoff elements
+    template<typename Iterator, typename Compare>
+    void parallel_sort(Iterator begin, Iterator end, Compare compare, int cutoff = 1 << 14)
+    {
+        if (thread_count() == 1 || end - begin <= cutoff)
+        {
+            std::sort(begin, end, compare);
+        }
+        else
+        {
+            Iterator middle{ begin + (end - begin) / 2 };
+            fork_join(
+                [&]() { parallel_sort(begin, middle, compare, cutoff); },
+                [&]() { parallel_sort(middle, end, compare, cutoff); }
+            );
+            std::inplace_merge(begin, middle, end, compare);
+        }
+    }
+}
@@ -0,0 +1,786 @@
+#include <PointIO.h>
+
+#include <KillZone.h>
+#include <Parallel.h>
+#include <Predicates.h>
+
+#include <algorithm>
+#include <cassert>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <future>
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace ch
+{
+    // size of the buffer of text_point_reader. it grows if a line doesn't fit
+    static constexpr size_t TEXT_POINT_READER_BUFFER_SIZE{ 1 << 20 };
+
+    static const char* skip_spaces(const char* begin, const char* end)
+    {
+        while (begin != end && (*begin == ' ' || *begin == '\t' || *begin == '\r'))
+        {
+            begin++;
+        }
+        return begin;
+    }
+
+    // parses a "x y" line
+    static bool parse_point(const char* begin, const char* end, v2& p)
+    {
+        begin = skip_spaces(begin, end);
+        auto [x_end, x_error] { std::from_chars(begin, end, p.x) };
+        if (x_error != std::errc{})
+        {
+            return false;
+        }
+        begin = skip_spaces(x_end, end);
+        auto [y_end, y_error] { std::from_chars(begin, end, p.y) };
+        if (y_error != std::errc{})
+        {
+            return false;
+        }
+        return skip_spaces(y_end, end) == end;
+    }
+
+    // parses a line holding a points count
+    static bool parse_count(const char* begin, const char* end, long long& count)
+    {
+        begin = skip_spaces(begin, end);
+        auto [count_end, count_error] { std::from_chars(begin, end, count) };
+        return count_error == std::errc{} && skip_spaces(count_end, end) == end && count >= 0;
+    }
+
+    text_point_reader::text_point_reader(const std::string& path)
+        : m_file{ path, std::ios::binary }
+        , m_buffer(TEXT_POINT_READER_BUFFER_SIZE)
+    {
+        if (!m_file)
+        {
+            m_error = "can't open " + path;
+            return;
+        }
+
+        const char* begin{};
+        const char* end{};
+        if (!next_line(begin, end))
+        {
+            fail("missing points count");
+            return;
+        }
+        if (!parse_count(begin, end, m_count))
+        {
+            fail("malformed points count");
+        }
+    }
+
+    bool text_point_reader::fail(const std::string& message)
+    {
+        m_error = "line " + std::to_string(m_line) + ": " + message;
+        m_count = m_read_count; // nothing more can be read
+        return false;
+    }
+
+    // returns the next line, without its line terminator, or false if the file is over
+    bool text_point_reader::next_line(const char*& begin, const char*& end)
+    {
+        while (true)
+        {
+            char* unparsed{ m_buffer.data() + m_begin };
+            char* newline{ static_cast<char*>(std::memchr(unparsed, '\n', m_end - m_begin)) };
+            if (newline || (m_eof && m_begin != m_end))
+            {
+                begin = unparsed;
+                end = newline ? newline : m_buffer.data() + m_end;
+                m_begin = newline ? newline - m_buffer.data() + 1 : m_end;
+                m_line++;
+                return true;
+            }
+            if (m_eof)
+            {
+                return false;
+            }
+
+            // move the partial line to the front of the buffer, and fill the rest of it
+            std::memmove(m_buffer.data(), unparsed, m_end - m_begin);
+            m_end -= m_begin;
+            m_begin = 0;
+            if (m_end == m_buffer.size())
+            {
+                m_buffer.resize(2 * m_buffer.size());
+            }
+            m_file.read(m_buffer.data() + m_end, static_cast<std::streamsize>(m_buffer.size() - m_end));
+            m_end += static_cast<size_t>(m_file.gcount());
+            m_eof = !m_file;
+        }
+    }
+
+    bool text_point_reader::read(std::vector<v2>& points, int max_count)
+    {
+        assert(max_count > 0);
+
+        points.clear();
+        if (!m_error.empty())
+        {
+            return false;
+        }
+
+        while (static_cast<int>(points.size()) < max_count && m_read_count < m_count)
+        {
+            const char* begin{};
+            const char* end{};
+            if (!next_line(begin, end))
+            {
+                m_error = "expected " + std::to_string(m_count) + " points, found " + std::to_string(m_read_count);
+                m_count = m_read_count;
+                return false;
+            }
+            if (skip_spaces(begin, end) == end)
+            {
+                continue; // blank line
+            }
+
+            v2 p{};
+            if (!parse_point(begin, end, p))
+            {
+                return fail("malformed point");
+            }
+            points.emplace_back(p);
+            m_read_count++;
+        }
+        return true;
+    }
+
+    bool text_point_reader::read_hull(std::vector<v2>& hull)
+    {
+        assert(done());
+
+        hull.clear();
+        if (!m_error.empty())
+        {
+            return false;
+        }
+
+        // skip blank lines, up to the hull count (if any)
+        const char* begin{};
+        const char* end{};
+        do
+        {
+            if (!next_line(begin, end))
+            {
+                return true; // no hull
+            }
+        } while (skip_spaces(begin, end) == end);
+
+        long long hull_count{};
+        if (!parse_count(begin, end, hull_count))
+        {
+            return fail("malformed hull points count");
+        }
+        while (static_cast<long long>(hull.size()) < hull_count)
+        {
+            if (!next_line(begin, end))
+            {
+                m_error = "expected " + std::to_string(hull_count) + " hull points, found " + std::to_string(hull.size());
+                return false;
+            }
+            if (skip_spaces(begin, end) == end)
+            {
+                continue; // blank line
+            }
+
+            v2 p{};
+            if (!parse_point(begin, end, p))
+            {
+                return fail("malformed hull point");
+            }
+            hull.emplace_back(p);
+        }
+        return true;
+    }
+
+    // smallest chunk of a text point file parsed by a single task
+    static constexpr size_t PARSE_TEXT_POINTS_MIN_CHUNK_SIZE{ 1 << 20 };
+
+    struct text_chunk
+    {
+        const char* begin{};
+        const char* end{};
+        long long lines_count{};     // blank lines included
+        long long points_count{};    // blank lines excluded
+        long long first_line{};      // line number of the first line of the chunk
+        long long first_point{};     // index of the first point of the chunk
+        long long error_line{};      // first malformed line, 0 if none
+    };
+
+    // counts the lines of chunk, and how many of them are not blank
+    static void count_lines(text_chunk& chunk)
+    {
+        const char* line{ chunk.begin };
+        while (line != chunk.end)
+        {
+            const char* newline{ static_cast<const char*>(std::memchr(line, '\n', chunk.end - line)) };
+            const char* line_end{ newline ? newline : chunk.end };
+            chunk.lines_count++;
+            chunk.points_count += skip_spaces(line, line_end) != line_end;
+            line = newline ? newline + 1 : chunk.end;
+        }
+    }
+
+    // parses the lines of chunk that hold the points [0, count), into points
+    static void parse_lines(text_chunk& chunk, v2* points, long long count)
+    {
+        long long line_number{ chunk.first_line };
+        long long point{ chunk.first_point };
+        const char* line{ chunk.begin };
+        while (line != chunk.end && point < count)
+        {
+            const char* newline{ static_cast<const char*>(std::memchr(line, '\n', chunk.end - line)) };
+            const char* line_end{ newline ? newline : chunk.end };
+            if (skip_spaces(line, line_end) != line_end)
+            {
+                if (!parse_point(line, line_end, points[point]))
+                {
+                    chunk.error_line = line_number;
+                    return;
+                }
+                point++;
+            }
+            line_number++;
+            line = newline ? newline + 1 : chunk.end;
+        }
+    }
+
+    text_parse_result parse_text_points(const std::string& path)
+    {
+        text_parse_result result{};
+        auto start{ std::chrono::high_resolution_clock::now() };
+        auto stop_clock{ [&]()
+        {
+            auto end{ std::chrono::high_resolution_clock::now() };
+            result.seconds = std::chrono::duration<double>(end - start).count();
+            result.megabytes_per_second = result.seconds > 0.0 ? static_cast<double>(result.bytes) / 1e6 / result.seconds : 0.0;
+        } };
+
+        // map the whole file
+        file_mapping text{ path };
+        if (!text.is_open())
+        {
+            result.error = "can't open or map " + path;
+            stop_clock();
+            return result;
+        }
+        result.bytes = static_cast<long long>(text.size());
+
+        // points count, from the first line
+        const char* text_begin{ text.data() };
+        const char* text_end{ text.data() + text.size() };
+        const char* newline{ static_cast<const char*>(std::memchr(text_begin, '\n', text.size())) };
+        const char* body{ newline ? newline + 1 : text_end };
+        long long count{};
+        if (!parse_count(text_begin, newline ? newline : text_end, count))
+        {
+            result.error = "line 1: malformed points count";
+            stop_clock();
+            return result;
+        }
+        result.points.resize(static_cast<size_t>(count));
+
+        // split the rest of the file into chunks that begin right after a newline
+        size_t body_size{ static_cast<size_t>(text_end - body) };
+        int chunk_count{ static_cast<int>(std::clamp<size_t>(body_size / PARSE_TEXT_POINTS_MIN_CHUNK_SIZE, 1, thread_count() * 4)) };
+        std::vector<text_chunk> chunks(chunk_count);
+        for (int i{}; i < chunk_count; i++)
+        {
+            const char* begin{ i == 0 ? body : chunks[i - 1].end };
+            const char* end{ text_end };
+            if (i + 1 < chunk_count)
+            {
+                const char* nominal_end{ std::max(begin, body + body_size * (i + 1) / chunk_count) };
+                const char* chunk_newline{ static_cast<const char*>(std::memchr(nominal_end, '\n', text_end - nominal_end)) };
+                end = chunk_newline ? chunk_newline + 1 : text_end;
+            }
+            chunks[i].begin = begin;
+            chunks[i].end = end;
+        }
+
+        // count the lines of every chunk, so that every chunk knows where its points go
+        parallel_for(chunk_count, [&](int begin, int end)
+        {
+            for (int i{ begin }; i < end; i++)
+            {
+                count_lines(chunks[i]);
+            }
+        });
+        long long line{ 2 };
+        long long point{};
+        for (text_chunk& chunk : chunks)
+        {
+            chunk.first_line = line;
+            chunk.first_point = point;
+            line += chunk.lines_count;
+            point += chunk.points_count;
+        }
+        if (point < count)
+        {
+            // lines after the points (e.g. a hull) are counted as well, so this only catches truncated files
+            result.error = "expected " + std::to_string(count) + " points, found " + std::to_string(point);
+            result.points.clear();
+            stop_clock();
+            return result;
+        }
+
+        parallel_for(chunk_count, [&](int begin, int end)
+        {
+            for (int i{ begin }; i < end; i++)
+            {
+                parse_lines(chunks[i], result.points.data(), count);
+            }
+        });
+        for (const text_chunk& chunk : chunks)
+        {
+            if (chunk.error_line != 0)
+            {
+                result.error = "line " + std::to_string(chunk.error_line) + ": malformed point";
+                result.points.clear();
+                break;
+            }
+        }
+        stop_clock();
+        return result;
+    }
+
+    static std::uint64_t coordinate_size(coordinate_type type)
+    {
+        return type == coordinate_type::f64 ? sizeof(double) : sizeof(float);
+    }
+
+    static std::uint64_t align_to_64(std::uint64_t offset)
+    {
+        return (offset + 63) / 64 * 64;
+    }
+
+    static binary_point_header make_binary_point_header(std::uint64_t count, std::uint64_t hull_count, coordinate_type type, point_layout layout)
+    {
+        binary_point_header header{};
+        std::copy(std::begin(BINARY_POINT_MAGIC), std::end(BINARY_POINT_MAGIC), header.magic);
+        header.version = BINARY_POINT_VERSION;
+        header.type = type;
+        header.layout = layout;
+        header.count = count;
+        header.hull_count = hull_count;
+        header.points_offset = align_to_64(sizeof(binary_point_header));
+        header.hull_offset = align_to_64(header.points_offset + 2 * count * coordinate_size(type));
+        return header;
+    }
+
+    template<typename T>
+    static void write_values(std::ofstream& out, std::uint64_t offset, const std::vector<T>& values)
+    {
+        out.seekp(static_cast<std::streamoff>(offset));
+        out.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+    }
+
+    // writes points[0, count), that are the points [first, first + count) of the file
+    template<typename T>
+    static void write_coordinates(std::ofstream& out, const binary_point_header& header, std::uint64_t first, const v2* points, int count)
+    {
+        if (header.layout == point_layout::aos)
+        {
+            std::vector<T> values(2 * static_cast<size_t>(count));
+            for (int i{}; i < count; i++)
+            {
+                values[2 * i + 0] = static_cast<T>(points[i].x);
+                values[2 * i + 1] = static_cast<T>(points[i].y);
+            }
+            write_values(out, header.points_offset + 2 * first * sizeof(T), values);
+        }
+        else
+        {
+            std::vector<T> values(count);
+            for (int i{}; i < count; i++)
+            {
+                values[i] = static_cast<T>(points[i].x);
+            }
+            write_values(out, header.points_offset + first * sizeof(T), values);
+            for (int i{}; i < count; i++)
+            {
+                values[i] = static_cast<T>(points[i].y);
+            }
+            write_values(out, header.points_offset + (header.count + first) * sizeof(T), values);
+        }
+    }
+
+    static void write_coordinates(std::ofstream& out, const binary_point_header& header, std::uint64_t first, const v2* points, int count)
+    {
+        if (header.type == coordinate_type::f64)
+        {
+            write_coordinates<double>(out, header, first, points, count);
+        }
+        else
+        {
+            write_coordinates<float>(out, header, first, points, count);
+        }
+    }
+
+    // writes the header and the hull, and pads the file up to the end of the hull
+    static void write_header_and_hull(std::ofstream& out, const binary_point_header& header, const std::vector<v2>& hull)
+    {
+        out.seekp(0);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.seekp(static_cast<std::streamoff>(header.hull_offset));
+        out.write(reinterpret_cast<const char*>(hull.data()), static_cast<std::streamsize>(hull.size() * sizeof(v2)));
+        std::uint64_t points_end{ header.points_offset + 2 * header.count * coordinate_size(header.type) };
+        if (hull.empty() && (header.hull_offset > points_end || header.count == 0))
+        {
+            // make sure the file covers the padding after the points
+            char zero{};
+            out.seekp(static_cast<std::streamoff>(header.hull_offset) - 1);
+            out.write(&zero, 1);
+        }
+    }
+
+    bool write_binary_points(const std::string& path, const std::vector<v2>& points, const std::vector<v2>& hull, coordinate_type type, point_layout layout)
+    {
+        std::ofstream out{ path, std::ios::binary | std::ios::trunc };
+        if (!out)
+        {
+            return false;
+        }
+
+        binary_point_header header{ make_binary_point_header(points.size(), hull.size(), type, layout) };
+        write_coordinates(out, header, 0, points.data(), static_cast<int>(points.size()));
+        write_header_and_hull(out, header, hull);
+        return static_cast<bool>(out);
+    }
+
+    bool convert_text_to_binary(const std::string& text_path, const std::string& binary_path, coordinate_type type, point_layout layout, std::string* error)
+    {
+        auto failed{ [&](const std::string& message)
+        {
+            if (error)
+            {
+                *error = message;
+            }
+            return false;
+        } };
+
+        text_point_reader reader{ text_path };
+        if (!reader.error().empty())
+        {
+            return failed(reader.error());
+        }
+        std::ofstream out{ binary_path, std::ios::binary | std::ios::trunc };
+        if (!out)
+        {
+            return failed("can't open " + binary_path);
+        }
+
+        // the hull count is only known at the end, so the header is written last
+        binary_point_header header{ make_binary_point_header(static_cast<std::uint64_t>(reader.count()), 0, type, layout) };
+        std::vector<v2> chunk{};
+        std::uint64_t written_count{};
+        while (!reader.done())
+        {
+            if (!reader.read(chunk, STREAMING_HULL_CHUNK_SIZE))
+            {
+                return failed(reader.error());
+            }
+            write_coordinates(out, header, written_count, chunk.data(), static_cast<int>(chunk.size()));
+            written_count += chunk.size();
+        }
+
+        std::vector<v2> hull{};
+        if (!reader.read_hull(hull))
+        {
+            return failed(reader.error());
+        }
+        header.hull_count = hull.size();
+        write_header_and_hull(out, header, hull);
+        if (!out)
+        {
+            return failed("can't write " + binary_path);
+        }
+        return true;
+    }
+
+    file_mapping::file_mapping(const std::string& path)
+    {
+    #if defined(_WIN32)
+        HANDLE file{ CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr) };
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            return;
+        }
+        m_file = file;
+        LARGE_INTEGER size{};
+        if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+        {
+            return;
+        }
+        m_mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        const void* data{ m_mapping ? MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0) : nullptr };
+        if (!data)
+        {
+            return;
+        }
+        m_data = static_cast<const char*>(data);
+        m_size = static_cast<size_t>(size.QuadPart);
+    #else
+        int file{ open(path.c_str(), O_RDONLY) };
+        if (file == -1)
+        {
+            return;
+        }
+        struct stat status{};
+        void* data{ fstat(file, &status) == 0 && status.st_size > 0 ? mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0) : MAP_FAILED };
+        close(file); // the mapping keeps the file alive
+        if (data == MAP_FAILED)
+        {
+            return;
+        }
+        m_data = static_cast<const char*>(data);
+        m_size = static_cast<size_t>(status.st_size);
+    #endif
+    }
+
+    file_mapping::~file_mapping()
+    {
+    #if defined(_WIN32)
+        if (m_data)
+        {
+            UnmapViewOfFile(m_data);
+        }
+        if (m_mapping)
+        {
+            CloseHandle(m_mapping);
+        }
+        if (m_file)
+        {
+            CloseHandle(m_file);
+        }
+    #else
+        if (m_data)
+        {
+            munmap(const_cast<char*>(m_data), m_size);
+        }
+    #endif
+    }
+
+    mapped_point_file::mapped_point_file(const std::string& path)
+        : m_mapping{ path }
+        , m_data{ m_mapping.data() }
+        , m_size{ m_mapping.size() }
+    {
+        if (!m_mapping.is_open())
+        {
+            fail("can't open or map " + path);
+            return;
+        }
+
+        // validate the header, so that the spans handed out never go past the end of the file
+        const binary_point_header* header{ reinterpret_cast<const binary_point_header*>(m_data) };
+        if (m_size < sizeof(binary_point_header) || !std::equal(std::begin(BINARY_POINT_MAGIC), std::end(BINARY_POINT_MAGIC), header->magic))
+        {
+            fail("not a binary point file: " + path);
+            return;
+        }
+        bool valid_format{
+            header->version == BINARY_POINT_VERSION &&
+            (header->type == coordinate_type::f64 || header->type == coordinate_type::f32) &&
+            (header->layout == point_layout::aos || header->layout == point_layout::soa) };
+        bool valid_offsets{
+            header->points_offset <= m_size && header->points_offset % 64 == 0 && header->hull_offset % 64 == 0 &&
+            header->count <= (m_size - header->points_offset) / (2 * coordinate_size(header->type)) &&
+            header->points_offset + 2 * header->count * coordinate_size(header->type) <= header->hull_offset &&
+            header->hull_offset <= m_size &&
+            header->hull_count <= (m_size - header->hull_offset) / sizeof(v2) };
+        if (!valid_format || !valid_offsets)
+        {
+            fail("corrupted binary point file: " + path);
+            return;
+        }
+        m_header = header;
+    }
+
+    bool mapped_point_file::fail(const std::string& message)
+    {
+        m_error = message;
+        m_header = nullptr;
+        return false;
+    }
+
+    std::span<const v2> mapped_point_file::points() const
+    {
+        assert(is_open() && type() == coordinate_type::f64 && layout() == point_layout::aos);
+        return { reinterpret_cast<const v2*>(coordinates()), static_cast<size_t>(m_header->count) };
+    }
+
+    std::span<const double> mapped_point_file::xs() const
+    {
+        assert(is_open() && type() == coordinate_type::f64 && layout() == point_layout::soa);
+        return { reinterpret_cast<const double*>(coordinates()), static_cast<size_t>(m_header->count) };
+    }
+
+    std::span<const double> mapped_point_file::ys() const
+    {
+        assert(is_open() && type() == coordinate_type::f64 && layout() == point_layout::soa);
+        return { reinterpret_cast<const double*>(coordinates()) + m_header->count, static_cast<size_t>(m_header->count) };
+    }
+
+    std::span<const v2> mapped_point_file::hull() const
+    {
+        assert(is_open());
+        return { reinterpret_cast<const v2*>(m_data + m_header->hull_offset), static_cast<size_t>(m_header->hull_count) };
+    }
+
+    template<typename T>
+    static std::vector<v2> to_points(const T* coordinates, std::uint64_t count, point_layout layout)
+    {
+        std::vector<v2> points(count);
+        for (std::uint64_t i{}; i < count; i++)
+        {
+            if (layout == point_layout::aos)
+            {
+                points[i] = { static_cast<double>(coordinates[2 * i + 0]), static_cast<double>(coordinates[2 * i + 1]) };
+            }
+            else
+            {
+                points[i] = { static_cast<double>(coordinates[i]), static_cast<double>(coordinates[count + i]) };
+            }
+        }
+        return points;
+    }
+
+    std::vector<v2> mapped_point_file::to_points() const
+    {
+        assert(is_open());
+
+        if (type() == coordinate_type::f64)
+        {
+            return ch::to_points(reinterpret_cast<const double*>(coordinates()), m_header->count, layout());
+        }
+        else
+        {
+            return ch::to_points(reinterpret_cast<const float*>(coordinates()), m_header->count, layout());
+        }
+    }
+
+    // p is strictly inside of the clockwise hull (at least 3 points). O(log h), by binary search on the fan of hull[0]
+    static bool strictly_inside(const std::vector<v2>& hull, v2 p)
+    {
+        v2 origin{ hull[0] };
+        int last{ static_cast<int>(hull.size()) - 1 };
+        if (orientation(origin, hull[1], p) >= 0 || orientation(origin, hull[last], p) <= 0)
+        {
+            return false;
+        }
+
+        // find the wedge hull[lo] -> hull[lo + 1] of the fan that p falls within
+        int lo{ 1 };
+        int hi{ last };
+        while (hi - lo > 1)
+        {
+            int middle{ lo + (hi - lo) / 2 };
+            if (orientation(origin, hull[middle], p) < 0)
+            {
+                lo = middle;
+            }
+            else
+            {
+                hi = middle;
+            }
+        }
+        return orientation(hull[lo], hull[lo + 1], p) < 0;
+    }
+
+    // the points of chunk that may be hull vertices are folded into the running hull
+    static void streaming_hull_fold(std::vector<v2>& hull, const std::vector<v2>& chunk, std::vector<v2>& survivors)
+    {
+        if (hull.size() < 3)
+        {
+            survivors = hull;
+            survivors.insert(survivors.end(), chunk.begin(), chunk.end());
+            if (survivors.size() >= 3)
+            {
+                hull = akl_toussaint(survivors);
+            }
+            else
+            {
+                hull = survivors;
+            }
+            return;
+        }
+
+        // regular kill zone: the quadrilateral of the extremes of the hull
+        auto compare_x{ [](v2 a, v2 b) { return a.x < b.x; } };
+        auto compare_y{ [](v2 a, v2 b) { return a.y < b.y; } };
+        std::vector<v2> kill_zone{};
+        for (v2 p : {
+            *std::min_element(hull.begin(), hull.end(), compare_x),
+            *std::max_element(hull.begin(), hull.end(), compare_y),
+            *std::max_element(hull.begin(), hull.end(), compare_x),
+            *std::min_element(hull.begin(), hull.end(), compare_y) })
+        {
+            if (std::find(kill_zone.begin(), kill_zone.end(), p) == kill_zone.end())
+            {
+                kill_zone.emplace_back(p);
+            }
+        }
+        survivors.resize(chunk.size());
+        int survivors_count{ filter_kill_zone(chunk.data(), static_cast<int>(chunk.size()), make_kill_zone_planes(kill_zone), survivors.data()) };
+
+        // then the hull itself, keeping the hull vertices in front of the survivors
+        auto survivors_end{ std::remove_if(survivors.begin(), survivors.begin() + survivors_count, [&](v2 p) { return strictly_inside(hull, p); }) };
+        survivors.erase(survivors_end, survivors.end());
+        if (survivors.empty())
+        {
+            return;
+        }
+        survivors.insert(survivors.begin(), hull.begin(), hull.end());
+        hull = monotone_chain(survivors);
+    }
+
+    streaming_hull_result streaming_hull(const std::string& path, int chunk_size)
+    {
+        assert(chunk_size > 0);
+
+        streaming_hull_result result{};
+        auto start{ std::chrono::high_resolution_clock::now() };
+
+        text_point_reader reader{ path };
+        std::vector<v2> chunks[2]{};
+        std::vector<v2> survivors{};
+        int current{};
+        bool ok{ reader.read(chunks[current], chunk_size) };
+        while (ok && !chunks[current].empty())
+        {
+            // read the next chunk while folding the current one
+            std::future<bool> next{ std::async(std::launch::async, [&reader, &chunks, current, chunk_size]()
+            {
+                return reader.read(chunks[1 - current], chunk_size);
+            }) };
+            streaming_hull_fold(result.hull, chunks[current], survivors);
+            result.points_count += static_cast<long long>(chunks[current].size());
+            ok = next.get();
+            current = 1 - current;
+        }
+
+        auto end{ std::chrono::high_resolution_clock::now() };
+        result.error = reader.error();
+        result.seconds = std::chrono::duration<double>(end - start).count();
+        result.points_per_second = result.seconds > 0.0 ? static_cast<double>(result.points_count) / result.seconds : 0.0;
+        return result;
+    }
+}
@@ -0,0 +1,204 @@
+#pragma once
+
+#include <ConvexHull.h>
+
+#include <cstdint>
+#include <fstream>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace ch
+{
+    /*
+        Reads a text point file (as input.txt and test.txt) a piece at a time: the first line holds the points count,
+        then every line holds the x and y coordinates of a point. Anything after the points (e.g. a dumped hull) is ignored.
+        Only a fixed size buffer of the file is kept in memory, so that files larger than the memory can be read.
+    */
+    class text_point_reader
+    {
+    public:
+        explicit text_point_reader(const std::string& path);
+        ~text_point_reader() = default;
+        text_point_reader(const text_point_reader&) = delete;
+        text_point_reader(text_point_reader&&) noexcept = delete;
+        text_point_reader& operator=(const text_point_reader&) = delete;
+        text_point_reader& operator=(text_point_reader&&) noexcept = delete;
+    public:
+        // reads the next (at most) max_count points into points. returns false on error (see error())
+        bool read(std::vector<v2>& points, int max_count);
+        /*
+            Reads the hull that may follow the points (a count, then the points, as for the points themselves).
+            All the points must have been read already. hull is left empty if there is none.
+        */
+        bool read_hull(std::vector<v2>& hull);
+        // whether all the points of the file have been read
+        bool done() const { return m_read_count == m_count; }
+        long long count() const { return m_count; }
+        // empty if no error happened
+        const std::string& error() const { return m_error; }
+    private:
+        bool next_line(const char*& begin, const char*& end);
+        bool fail(const std::string& message);
+    private:
+        std::ifstream m_file;
+        std::vector<char> m_buffer;
+        size_t m_begin{};         // unparsed bytes of the buffer are in [m_begin, m_end)
+        size_t m_end{};
+        bool m_eof{};
+        long long m_line{};       // number of the last line returned by next_line, starting from 1
+        long long m_count{};
+        long long m_read_count{};
+        std::string m_error;
+    };
+
+    struct text_parse_result
+    {
+        std::vector<v2> points;
+        long long bytes{};          // size of the file
+        double seconds{};           // reading included
+        double megabytes_per_second{};
+        std::string error;          // empty on success, else the first malformed line
+    };
+
+    /*
+        Loads all the points of a text point file at once, as fast as possible: the file is mapped whole, split into chunks
+        that end at line boundaries, and the chunks are parsed in parallel (with std::from_chars) straight into the
+        points buffer, which is allocated upfront from the points count.
+        Each chunk counts its lines first, so that it knows where its points go and which line numbers it holds.
+    */
+    text_parse_result parse_text_points(const std::string& path);
+
+    enum class coordinate_type : std::uint32_t
+    {
+        f64, // double
+        f32, // float
+    };
+
+    enum class point_layout : std::uint32_t
+    {
+        aos, // x0 y0 x1 y1 ... (i.e. an array of v2, for f64)
+        soa, // x0 x1 ... y0 y1 ...
+    };
+
+    /*
+        Binary point file layout (native endianness), all offsets from the beginning of the file:
+        - binary_point_header
+        - at points_offset (a multiple of 64), count points with the given coordinate type and layout
+        - at hull_offset (a multiple of 64), hull_count hull points, always as f64 and aos. hull_count is 0 if there is
+          no precomputed hull
+    */
+    struct binary_point_header
+    {
+        char magic[8];            // BINARY_POINT_MAGIC
+        std::uint32_t version;    // BINARY_POINT_VERSION
+        coordinate_type type;
+        point_layout layout;
+        std::uint32_t reserved;
+        std::uint64_t count;
+        std::uint64_t hull_count;
+        std::uint64_t points_offset;
+        std::uint64_t hull_offset;
+    };
+
+    constexpr char BINARY_POINT_MAGIC[8]{ 'C', 'H', 'P', 'O', 'I', 'N', 'T', 'S' };
+    constexpr std::uint32_t BINARY_POINT_VERSION{ 1 };
+
+    // writes points (and the hull, if not empty) as a binary point file. returns false on error
+    bool write_binary_points(const std::string& path, const std::vector<v2>& points, const std::vector<v2>& hull = {},
+        coordinate_type type = coordinate_type::f64, point_layout layout = point_layout::aos);
+
+    /*
+        Converts a text point file (including the hull that may follow the points, as in test.txt) to a binary point file.
+        The text file is read a chunk at a time, so that it may be larger than the memory. Returns false on error, which
+        is then stored in error (if not null).
+    */
+    bool convert_text_to_binary(const std::string& text_path, const std::string& binary_path,
+        coordinate_type type = coordinate_type::f64, point_layout layout = point_layout::aos, std::string* error = nullptr);
+
+    // read only view of a whole (non empty) file, mapped in memory
+    class file_mapping
+    {
+    public:
+        explicit file_mapping(const std::string& path);
+        ~file_mapping();
+        file_mapping(const file_mapping&) = delete;
+        file_mapping(file_mapping&&) noexcept = delete;
+        file_mapping& operator=(const file_mapping&) = delete;
+        file_mapping& operator=(file_mapping&&) noexcept = delete;
+    public:
+        bool is_open() const { return m_data != nullptr; }
+        const char* data() const { return m_data; }
+        size_t size() const { return m_size; }
+    private:
+        const char* m_data{};
+        size_t m_size{};
+    #if defined(_WIN32)
+        void* m_file{};
+        void* m_mapping{};
+    #endif
+    };
+
+    /*
+        Binary point file mapped in memory: its coordinates are read in place, without being parsed or copied.
+        f64 coordinates can be handed straight to the algorithms, as a span of v2 (aos) or as two spans of doubles (soa).
+    */
+    class mapped_point_file
+    {
+    public:
+        explicit mapped_point_file(const std::string& path);
+        ~mapped_point_file() = default;
+        mapped_point_file(const mapped_point_file&) = delete;
+        mapped_point_file(mapped_point_file&&) noexcept = delete;
+        mapped_point_file& operator=(const mapped_point_file&) = delete;
+        mapped_point_file& operator=(mapped_point_file&&) noexcept = delete;
+    public:
+        bool is_open() const { return m_header != nullptr; }
+        // empty if the file was mapped successfully
+        const std::string& error() const { return m_error; }
+
+        int size() const { return static_cast<int>(m_header->count); }
+        coordinate_type type() const { return m_header->type; }
+        point_layout layout() const { return m_header->layout; }
+
+        // f64 and aos only
+        std::span<const v2> points() const;
+        // f64 and soa only
+        std::span<const double> xs() const;
+        std::span<const double> ys() const;
+        // empty if the file has no precomputed hull
+        std::span<const v2> hull() const;
+        // copy of the points, for any coordinate type and layout
+        std::vector<v2> to_points() const;
+    private:
+        bool fail(const std::string& message);
+        const char* coordinates() const { return m_data + m_header->points_offset; }
+    private:
+        file_mapping m_mapping;
+        const char* m_data{};
+        size_t m_size{};
+        const binary_point_header* m_header{};
+        std::string m_error;
+    };
+
+    // points of a text point file are streamed in chunks of this many points
+    constexpr int STREAMING_HULL_CHUNK_SIZE{ 1 << 20 };
+
+    struct streaming_hull_result
+    {
+        std::vector<v2> hull;
+        long long points_count{};
+        double seconds{};           // end to end, reading included
+        double points_per_second{};
+        std::string error;          // empty on success
+    };
+
+    /*
+        Hull of the points of a text point file, without ever loading all of them: peak memory is O(chunk_size + h).
+        The first chunk is solved with akl_toussaint. Then the running hull acts as the kill zone of the next chunks:
+        their points are filtered first by the quadrilateral of its extremes (the regular kill zone) and then by the
+        hull itself, and the few survivors are folded into the running hull. The next chunk is read on a background
+        thread while the current one is being filtered.
+    */
+    streaming_hull_result streaming_hull(const std::string& path, int chunk_size = STREAMING_HULL_CHUNK_SIZE);
+}
@@ -0,0 +1,52 @@
+#include <PointSet.h>
+
+#include <cassert>
+
+namespace ch
+{
+    point_set::point_set(int count)
+        : m_xs(count)
+        , m_ys(count)
+    {
+        assert(count >= 0);
+    }
+
+    point_set::point_set(const std::vector<v2>& points)
+        : point_set{ static_cast<int>(points.size()) }
+    {
+        for (int i{}; i < size(); i++)
+        {
+            set(i, points[i]);
+        }
+    }
+
+    void point_set::resize(int count)
+    {
+        assert(count >= 0);
+        m_xs.resize(count);
+        m_ys.resize(count);
+    }
+
+    void point_set::reserve(int count)
+    {
+        assert(count >= 0);
+        m_xs.reserve(count);
+        m_ys.reserve(count);
+    }
+
+    void point_set::push_back(v2 p)
+    {
+        m_xs.push_back(p.x);
+        m_ys.push_back(p.y);
+    }
+
+    std::vector<v2> point_set::to_points() const
+    {
+        std::vector<v2> points(size());
+        for (int i{}; i < size(); i++)
+        {
+            points[i] = (*this)[i];
+        }
+        return points;
+    }
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <ConvexHull.h>
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace ch
+{
+    // every coordinate array of a point_set starts on a cache line, which is also enough for any SIMD load
+    constexpr std::size_t POINT_SET_ALIGNMENT{ 64 };
+
+    template<typename T>
+    struct aligned_allocator
+    {
+        using value_type = T;
+
+        aligned_allocator() = default;
+        template<typename U>
+        aligned_allocator(const aligned_allocator<U>&) noexcept {}
+
+        T* allocate(std::size_t count)
+        {
+            return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t{ POINT_SET_ALIGNMENT }));
+        }
+        void deallocate(T* p, std::size_t) noexcept
+        {
+            ::operator delete(p, std::align_val_t{ POINT_SET_ALIGNMENT });
+        }
+
+        template<typename U>
+        bool operator==(const aligned_allocator<U>&) const noexcept { return true; }
+    };
+
+    /*
+        Point set stored as a structure of arrays: all the x coordinates are contiguous, and so are all the y coordinates.
+        Hull algorithms taking a point_set read the coordinates straight from these arrays, so that extreme point
+        searches and kill zone filtering work on full SIMD lanes, without any conversion from std::vector<v2>.
+    */
+    class point_set
+    {
+    public:
+        point_set() = default;
+        explicit point_set(int count);
+        explicit point_set(const std::vector<v2>& points);
+    public:
+        int size() const { return static_cast<int>(m_xs.size()); }
+        bool empty() const { return m_xs.empty(); }
+
+        const double* xs() const { return m_xs.data(); }
+        const double* ys() const { return m_ys.data(); }
+        double* xs() { return m_xs.data(); }
+        double* ys() { return m_ys.data(); }
+
+        v2 operator[](int i) const { return { m_xs[i], m_ys[i] }; }
+        void set(int i, v2 p) { m_xs[i] = p.x; m_ys[i] = p.y; }
+
+        void resize(int count);
+        void reserve(int count);
+        void push_back(v2 p);
+
+        std::vector<v2> to_points() const;
+    private:
+        std::vector<double, aligned_allocator<double>> m_xs;
+        std::vector<double, aligned_allocator<double>> m_ys;
+    };
+}
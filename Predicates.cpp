@@ -0,0 +1,177 @@
+#include <Predicates.h>
+
+#include <cassert>
+#include <cmath>
+
+namespace ch
+{
+    /*
+        Floating point expansions: a number is represented exactly as the sum of doubles whose magnitudes increase and
+        whose bits don't overlap. The sign of an expansion is the sign of its largest (i.e. last) component.
+    */
+
+    // x + y == a + b exactly, with x = fl(a + b)
+    static void two_sum(double a, double b, double& x, double& y)
+    {
+        x = a + b;
+        double b_virtual{ x - a };
+        double a_virtual{ x - b_virtual };
+        double b_roundoff{ b - b_virtual };
+        double a_roundoff{ a - a_virtual };
+        y = a_roundoff + b_roundoff;
+    }
+
+    // x + y == a - b exactly, with x = fl(a - b)
+    static void two_diff(double a, double b, double& x, double& y)
+    {
+        x = a - b;
+        double b_virtual{ a - x };
+        double a_virtual{ x + b_virtual };
+        double b_roundoff{ b_virtual - b };
+        double a_roundoff{ a - a_virtual };
+        y = a_roundoff + b_roundoff;
+    }
+
+    // x + y == a * b exactly, with x = fl(a * b). the fused multiply add gives the rounding error of the product
+    static void two_product(double a, double b, double& x, double& y)
+    {
+        x = a * b;
+        y = std::fma(a, b, -x);
+    }
+
+    /*
+        h = e + b, where e[0, e_count) is an expansion. Returns the number of components of h, at most e_count + 1.
+        Zero components are dropped. h may coincide with e.
+    */
+    static int grow_expansion(const double* e, int e_count, double b, double* h)
+    {
+        double q{ b };
+        int h_count{};
+        for (int i{}; i < e_count; i++)
+        {
+            double sum{}, error{};
+            two_sum(q, e[i], sum, error);
+            q = sum;
+            if (error != 0)
+            {
+                h[h_count++] = error;
+            }
+        }
+        if (q != 0 || h_count == 0)
+        {
+            h[h_count++] = q;
+        }
+        return h_count;
+    }
+
+    // adds the exact product a * b to the expansion e[0, e_count), in place. e must have room for two more components
+    static int add_product(double* e, int e_count, double a, double b)
+    {
+        double product{}, error{};
+        two_product(a, b, product, error);
+        e_count = grow_expansion(e, e_count, error, e);
+        return grow_expansion(e, e_count, product, e);
+    }
+
+    // e = determinant(b - a, d - c) exactly, as an expansion of at most 16 components. Returns their number
+    static int orientation_expansion(v2 a, v2 b, v2 c, v2 d, double* e)
+    {
+        // the differences are often exact (e.g. when the points are close to each other): then two products are enough
+        double bax{}, bay{}, dcx{}, dcy{};
+        double bax_error{}, bay_error{}, dcx_error{}, dcy_error{};
+        two_diff(b.x, a.x, bax, bax_error);
+        two_diff(b.y, a.y, bay, bay_error);
+        two_diff(d.x, c.x, dcx, dcx_error);
+        two_diff(d.y, c.y, dcy, dcy_error);
+
+        // a repeated point, or twice the same vector (e.g. a point tested against a line through it): zero, with no products
+        bool ba_zero{ bax == 0 && bay == 0 && bax_error == 0 && bay_error == 0 };
+        bool dc_zero{ dcx == 0 && dcy == 0 && dcx_error == 0 && dcy_error == 0 };
+        bool same_vector{ bax == dcx && bay == dcy && bax_error == dcx_error && bay_error == dcy_error };
+        if (ba_zero || dc_zero || same_vector)
+        {
+            e[0] = 0.0;
+            return 1;
+        }
+
+        int e_count{};
+        if (bax_error == 0 && bay_error == 0 && dcx_error == 0 && dcy_error == 0)
+        {
+            e_count = add_product(e, e_count, bax, dcy);
+            e_count = add_product(e, e_count, -bay, dcx);
+        }
+        else
+        {
+            // (bx - ax) (dy - cy) - (by - ay) (dx - cx), expanded into products of coordinates
+            e_count = add_product(e, e_count, b.x, d.y);
+            e_count = add_product(e, e_count, -b.x, c.y);
+            e_count = add_product(e, e_count, -a.x, d.y);
+            e_count = add_product(e, e_count, a.x, c.y);
+            e_count = add_product(e, e_count, -b.y, d.x);
+            e_count = add_product(e, e_count, b.y, c.x);
+            e_count = add_product(e, e_count, a.y, d.x);
+            e_count = add_product(e, e_count, -a.y, c.x);
+        }
+        return e_count;
+    }
+
+    double orientation_exact(v2 a, v2 b, v2 c, v2 d)
+    {
+        count_hull_stat(hull_counter::orientation_fallbacks);
+
+        double e[18]{};
+        int e_count{ orientation_expansion(a, b, c, d, e) };
+        return e[e_count - 1];
+    }
+
+    double intersection_side(v2 a1, v2 a2, v2 b1, v2 b2, double x)
+    {
+        count_hull_stat(hull_counter::orientations);
+
+        /*
+            The intersection is at a1 + da * t, with t = determinant(b1 - a1, db) / determinant(da, db). So its x minus x
+            has the sign of n = (a1.x - x) determinant(da, db) + da.x determinant(b1 - a1, db), times the one of
+            determinant(da, db).
+        */
+        double denominator{ orientation(a1, a2, b1, b2) };
+        assert(denominator != 0);
+
+        v2 da{ a2 - a1 };
+        v2 db{ b2 - b1 };
+        v2 ba{ b1 - a1 };
+        double ax{ a1.x - x };
+        double d1{ determinant(da, db) };
+        double d2{ determinant(ba, db) };
+        double n{ ax * d1 + da.x * d2 };
+        double magnitude{ std::abs(ax) * (std::abs(da.x * db.y) + std::abs(da.y * db.x)) + std::abs(da.x) * (std::abs(ba.x * db.y) + std::abs(ba.y * db.x)) };
+        if (n > INTERSECTION_ERROR_BOUND * magnitude || -n > INTERSECTION_ERROR_BOUND * magnitude)
+        {
+            return denominator > 0 ? n : -n;
+        }
+
+        count_hull_stat(hull_counter::orientation_fallbacks);
+
+        double e1[18]{};
+        double e2[18]{};
+        int e1_count{ orientation_expansion(a1, a2, b1, b2, e1) };
+        int e2_count{ orientation_expansion(a1, b1, b1, b2, e2) };
+        double ax_high{}, ax_low{}, dax_high{}, dax_low{};
+        two_diff(a1.x, x, ax_high, ax_low);
+        two_diff(a2.x, a1.x, dax_high, dax_low);
+
+        // every product of a component of a difference and a component of a determinant adds at most two components
+        double e[4 * 16 * 2 + 2]{};
+        int e_count{};
+        for (int i{}; i < e1_count; i++)
+        {
+            e_count = add_product(e, e_count, ax_high, e1[i]);
+            e_count = add_product(e, e_count, ax_low, e1[i]);
+        }
+        for (int i{}; i < e2_count; i++)
+        {
+            e_count = add_product(e, e_count, dax_high, e2[i]);
+            e_count = add_product(e, e_count, dax_low, e2[i]);
+        }
+        return denominator > 0 ? e[e_count - 1] : -e[e_count - 1];
+    }
+}
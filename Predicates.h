@@ -0,0 +1,129 @@
+#pragma once
+
+#include <ConvexHull.h>
+#include <HullStats.h>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace ch
+{
+    /*
+        Robust geometric predicates (after Shewchuk, "Adaptive Precision Floating-Point Arithmetic and Fast Robust
+        Geometric Predicates").
+        A predicate is first evaluated in double precision, together with a bound on its rounding error. Only if the result
+        is within the bound (i.e. its sign may be wrong, which happens for collinear or nearly collinear points) the
+        predicate is evaluated again, exactly, with floating point expansions. So the sign is always exact, while inputs in
+        general position almost never leave the fast path.
+    */
+
+    // half the distance between 1.0 and the next double, i.e. the relative rounding error of a double operation
+    constexpr double PREDICATE_EPSILON{ std::numeric_limits<double>::epsilon() / 2.0 };
+    // relative error bound of a 2x2 determinant of point differences, computed in double precision (ccwerrboundA)
+    constexpr double ORIENTATION_ERROR_BOUND{ (3.0 + 16.0 * PREDICATE_EPSILON) * PREDICATE_EPSILON };
+    // relative error bound of intersection_side in double precision (conservative: the actual one is below 7 epsilon)
+    constexpr double INTERSECTION_ERROR_BOUND{ (8.0 + 64.0 * PREDICATE_EPSILON) * PREDICATE_EPSILON };
+
+    // exact evaluation of determinant(b - a, d - c), for when the double precision one is too close to zero
+    double orientation_exact(v2 a, v2 b, v2 c, v2 d);
+
+    /*
+        Returns a value with the exact sign of determinant(b - a, d - c): positive if the direction c -> d turns
+        counterclockwise from the direction a -> b, negative if it turns clockwise and zero if the two are parallel.
+    */
+    inline double orientation(v2 a, v2 b, v2 c, v2 d)
+    {
+        count_hull_stat(hull_counter::orientations);
+
+        double left{ (b.x - a.x) * (d.y - c.y) };
+        double right{ (b.y - a.y) * (d.x - c.x) };
+        double det{ left - right };
+
+        /*
+            A single test, with no branch on the signs of the products (they are as good as random, so such branches would
+            be mispredicted half of the time). If the products have opposite signs, the subtraction can't cancel and
+            |det| = |left| + |right|, which always passes.
+        */
+        if (std::abs(det) >= ORIENTATION_ERROR_BOUND * (std::abs(left) + std::abs(right)))
+        {
+            return det;
+        }
+        return orientation_exact(a, b, c, d);
+    }
+
+    /*
+        Returns a value with the exact sign of determinant(b - a, c - a): positive if c lies to the left of a -> b (i.e.
+        a -> b -> c is a counterclockwise turn), negative if it lies to the right (clockwise turn) and zero if a, b and c
+        are collinear.
+    */
+    inline double orientation(v2 a, v2 b, v2 c)
+    {
+        return orientation(a, b, a, c);
+    }
+
+    // float coordinates are evaluated in double precision: they are exactly representable, so the sign is still exact
+    inline double orientation(v2f a, v2f b, v2f c, v2f d)
+    {
+        return orientation(v2{ a.x, a.y }, v2{ b.x, b.y }, v2{ c.x, c.y }, v2{ d.x, d.y });
+    }
+
+    inline double orientation(v2f a, v2f b, v2f c)
+    {
+        return orientation(a, b, a, c);
+    }
+
+    /*
+        Returns the exact sign of p * q - r * s, where the factors are differences of int32 coordinates (i.e. less than
+        2^32 in absolute value). The products take up to 65 bits: they are computed with 128 bit integers if the compiler
+        has them, otherwise (e.g. on MSVC) the factors are split in 16 bit halves, whose partial products fit in 64 bits.
+    */
+    inline int difference_of_products_sign(std::int64_t p, std::int64_t q, std::int64_t r, std::int64_t s)
+    {
+#if defined(__SIZEOF_INT128__)
+        __int128 det{ static_cast<__int128>(p) * q - static_cast<__int128>(r) * s };
+        return (det > 0) - (det < 0);
+#else
+        // x = high * 2^16 + low with 0 <= low < 2^16 (>> is an arithmetic shift since C++20), and |high| <= 2^16
+        std::int64_t p_high{ p >> 16 }, p_low{ p & 0xFFFF };
+        std::int64_t q_high{ q >> 16 }, q_low{ q & 0xFFFF };
+        std::int64_t r_high{ r >> 16 }, r_low{ r & 0xFFFF };
+        std::int64_t s_high{ s >> 16 }, s_low{ s & 0xFFFF };
+
+        // p * q - r * s = high * 2^32 + middle * 2^16 + low, with each term well within 64 bits
+        std::int64_t high{ p_high * q_high - r_high * s_high };
+        std::int64_t middle{ p_high * q_low + p_low * q_high - r_high * s_low - r_low * s_high };
+        std::int64_t low{ p_low * q_low - r_low * s_low };
+
+        // carry the bits above 2^32 into high, so that det = high * 2^32 + rest with 0 <= rest < 2^32: its sign is the one of high, if any
+        std::int64_t rest{ middle * 65536 + low };
+        high += rest >> 32;
+        rest &= 0xFFFFFFFF;
+        return high != 0 ? (high > 0) - (high < 0) : (rest > 0);
+#endif
+    }
+
+    // int32 coordinates are always evaluated exactly, with differences in 64 bits: there is no fallback
+    inline double orientation(v2i a, v2i b, v2i c, v2i d)
+    {
+        count_hull_stat(hull_counter::orientations);
+
+        std::int64_t abx{ std::int64_t{ b.x } - a.x };
+        std::int64_t aby{ std::int64_t{ b.y } - a.y };
+        std::int64_t cdx{ std::int64_t{ d.x } - c.x };
+        std::int64_t cdy{ std::int64_t{ d.y } - c.y };
+        return difference_of_products_sign(abx, cdy, aby, cdx);
+    }
+
+    inline double orientation(v2i a, v2i b, v2i c)
+    {
+        return orientation(a, b, a, c);
+    }
+
+    /*
+        Returns a value with the exact sign of the x of the intersection of the line through a1 and a2 with the line
+        through b1 and b2, minus x: positive if the lines meet at the right of x, negative if at the left and zero if
+        exactly on it. The two lines must not be parallel.
+    */
+    double intersection_side(v2 a1, v2 a2, v2 b1, v2 b2, double x);
+}
@@ -0,0 +1,87 @@
+#include <ScratchHull.h>
+
+#include <KillZone.h>
+#include <MonotoneChain.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace ch
+{
+    // point sets with fewer points are sorted as they are, as filtering them costs more than it saves
+    static constexpr int SCRATCH_HULL_FILTER_MIN_COUNT{ 32 };
+
+    // scratch memory of the calling thread, which only ever grows
+    struct hull_scratch
+    {
+        std::vector<v2> sorted;
+        std::vector<v2> chain;
+        std::vector<v2> kill_zone;
+    };
+
+    static thread_local hull_scratch t_scratch{};
+
+    int scratch_hull(const v2* points, int count, v2* hull)
+    {
+        std::vector<v2>& sorted{ t_scratch.sorted };
+        std::vector<v2>& chain{ t_scratch.chain };
+        if (static_cast<int>(sorted.size()) < count)
+        {
+            sorted.resize(count);
+            chain.resize(2 * static_cast<size_t>(count));
+        }
+
+        if (count < SCRATCH_HULL_FILTER_MIN_COUNT)
+        {
+            std::copy(points, points + count, sorted.begin());
+        }
+        else
+        {
+            // akl-toussaint heuristic: points strictly inside the quadrilateral of the extremes are not on the hull
+            v2 left{ points[0] }, top{ points[0] }, right{ points[0] }, bottom{ points[0] };
+            for (int i{ 1 }; i < count; i++)
+            {
+                v2 p{ points[i] };
+                if (p.x < left.x) left = p;
+                if (p.y > top.y) top = p;
+                if (p.x > right.x) right = p;
+                if (p.y < bottom.y) bottom = p;
+            }
+            std::vector<v2>& kill_zone{ t_scratch.kill_zone }; // clockwise, without repeated extremes
+            kill_zone.clear();
+            for (v2 p : { left, top, right, bottom })
+            {
+                if (std::find(kill_zone.begin(), kill_zone.end(), p) == kill_zone.end())
+                {
+                    kill_zone.emplace_back(p);
+                }
+            }
+            count = filter_kill_zone(points, count, make_kill_zone_planes(kill_zone), sorted.data());
+        }
+        std::sort(sorted.begin(), sorted.begin() + count, [](v2 a, v2 b) { return a.x < b.x || (a.x == b.x && a.y < b.y); });
+        if (count < 3)
+        {
+            int size{ static_cast<int>(std::unique(sorted.begin(), sorted.begin() + count) - sorted.begin()) };
+            if (hull)
+            {
+                std::copy(sorted.begin(), sorted.begin() + size, hull);
+            }
+            return size;
+        }
+        if (sorted[0].x == sorted[count - 1].x && sorted[0].y == sorted[count - 1].y)
+        {
+            if (hull)
+            {
+                hull[0] = sorted[0]; // all points are the same
+            }
+            return 1;
+        }
+
+        int size{ monotone_chain_sorted(sorted.data(), count, chain.data()) };
+        if (hull)
+        {
+            std::copy(chain.begin(), chain.begin() + size, hull);
+        }
+        return size;
+    }
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <ConvexHull.h>
+
+namespace ch
+{
+    /*
+        Hull of points[0, count) (see monotone_chain: clockwise from the leftmost point, without collinear points), written
+        to hull if it is not null. Returns the hull size, at most count.
+        It runs on scratch memory of the calling thread, which only ever grows, so that it doesn't allocate: the many small
+        hulls of batch_hulls and of the probe of convex_hull would cost more in allocations than in the hull itself.
+        Point sets that are large enough are filtered by the akl-toussaint heuristic before they are sorted.
+    */
+    int scratch_hull(const v2* points, int count, v2* hull);
+}
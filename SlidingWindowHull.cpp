@@ -0,0 +1,143 @@
+#include <SlidingWindowHull.h>
+
+#include <algorithm>
+#include <cassert>
+
+namespace ch
+{
+    // same as incremental_hull, but logging the removed vertices so that the insertion can be undone
+    sliding_window_hull::chain_change sliding_window_hull::front_insert(upper_chain& upper, v2 p)
+    {
+        if (chain_contains(upper, p))
+        {
+            return {};
+        }
+        return { true, chain_insert(upper, p, &m_removed) };
+    }
+
+    void sliding_window_hull::front_undo(upper_chain& upper, v2 p, const chain_change& change)
+    {
+        if (!change.inserted)
+        {
+            return;
+        }
+
+        upper.erase(p.x);
+        for (int i{}; i < change.removed_count; i++)
+        {
+            upper.emplace(m_removed.back());
+            m_removed.pop_back();
+        }
+    }
+
+    void sliding_window_hull::push(v2 p, double time)
+    {
+        assert(empty() || time >= (m_back.empty() ? m_front.front().time : m_back.back().time));
+
+        m_back.push_back({ p, time });
+        m_back_hull.insert(p);
+    }
+
+    // moves all the points of the back stack to the front one, from the newest to the oldest
+    void sliding_window_hull::flip()
+    {
+        assert(m_front.empty());
+
+        for (auto it{ m_back.rbegin() }; it != m_back.rend(); it++)
+        {
+            v2 p{ it->point };
+            m_front.emplace_back(*it);
+            m_front_changes.emplace_back(front_insert(m_front_upper, p));
+            m_front_changes.emplace_back(front_insert(m_front_lower, { p.x, -p.y }));
+        }
+        m_back.clear();
+        m_back_hull = {};
+    }
+
+    bool sliding_window_hull::expire()
+    {
+        if (empty())
+        {
+            return false;
+        }
+        if (m_front.empty())
+        {
+            flip();
+        }
+
+        // undo the insertions of the oldest point, in reverse order
+        v2 p{ m_front.back().point };
+        front_undo(m_front_lower, { p.x, -p.y }, m_front_changes.back());
+        m_front_changes.pop_back();
+        front_undo(m_front_upper, p, m_front_changes.back());
+        m_front_changes.pop_back();
+        m_front.pop_back();
+        return true;
+    }
+
+    int sliding_window_hull::expire_before(double time)
+    {
+        int expired_count{};
+        while (!empty())
+        {
+            double oldest{ m_front.empty() ? m_back.front().time : m_front.back().time };
+            if (oldest >= time)
+            {
+                break;
+            }
+            expire();
+            expired_count++;
+        }
+        return expired_count;
+    }
+
+    std::vector<v2> sliding_window_hull::front_hull() const
+    {
+        std::vector<v2> hull{};
+        if (m_front_upper.empty())
+        {
+            return hull;
+        }
+
+        for (auto it{ m_front_upper.begin() }; it != m_front_upper.end(); it++)
+        {
+            hull.emplace_back(to_v2(it));
+        }
+        v2 first{ hull.front() };
+        v2 last{ hull.back() };
+        for (auto it{ m_front_lower.rbegin() }; it != m_front_lower.rend(); it++)
+        {
+            v2 p{ it->first, -it->second };
+            if (p != first && p != last)
+            {
+                hull.emplace_back(p);
+            }
+        }
+        return hull;
+    }
+
+    std::vector<v2> sliding_window_hull::hull() const
+    {
+        std::vector<v2> front{ front_hull() };
+        if (m_back.empty())
+        {
+            return front;
+        }
+        std::vector<v2> back{ m_back_hull.hull() };
+        if (front.empty())
+        {
+            return back;
+        }
+
+        // the two hulls may overlap, so they are merged by computing the hull of their vertices
+        std::vector<v2> vertices{ front };
+        vertices.insert(vertices.end(), back.begin(), back.end());
+        std::sort(vertices.begin(), vertices.end(), [](v2 a, v2 b) { return a.x < b.x || (a.x == b.x && a.y < b.y); });
+        vertices.erase(std::unique(vertices.begin(), vertices.end()), vertices.end());
+        if (vertices.size() < 3)
+        {
+            return vertices;
+        }
+        return monotone_chain(vertices);
+    }
+}
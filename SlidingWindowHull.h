@@ -0,0 +1,62 @@
+#pragma once
+
+#include <ConvexHull.h>
+#include <IncrementalHull.h>
+#include <UpperChain.h>
+
+#include <vector>
+
+namespace ch
+{
+    /*
+        Convex hull of a window over a stream of timestamped points: points are pushed at the back and expire from the
+        front, in the same order (e.g. to keep the last W points, or the points of the last T seconds).
+        The window is a queue made of two stacks. New points go to the back stack, whose hull is an incremental_hull.
+        When the front stack is empty and a point expires, the whole back stack is moved to the front one: its points are
+        inserted from the newest to the oldest into a pair of chains that remember how to undo every insertion, so that
+        expiring the oldest point just undoes the last insertion. Every point is moved once, so that push and expire
+        are O(log h) amortized. The hull of the window merges the hulls of the two stacks, in O(h log h).
+    */
+    class sliding_window_hull
+    {
+    public:
+        sliding_window_hull() = default;
+    public:
+        // time must not be lower than the one of the points already in the window
+        void push(v2 p, double time = 0.0);
+        // expires the oldest point. returns false if the window is empty
+        bool expire();
+        // expires all the points older than time, and returns how many
+        int expire_before(double time);
+        // clockwise hull of the window, starting from the leftmost point
+        std::vector<v2> hull() const;
+        int size() const { return static_cast<int>(m_front.size() + m_back.size()); }
+        bool empty() const { return m_front.empty() && m_back.empty(); }
+    private:
+        struct timed_point
+        {
+            v2 point;
+            double time;
+        };
+
+        // how an insertion changed a chain
+        struct chain_change
+        {
+            bool inserted;      // false if the point was below the chain
+            int removed_count;  // vertices removed from the chain (see chain_insert), on top of m_removed
+        };
+    private:
+        void flip();
+        chain_change front_insert(upper_chain& upper, v2 p);
+        void front_undo(upper_chain& upper, v2 p, const chain_change& change);
+        std::vector<v2> front_hull() const;
+    private:
+        std::vector<timed_point> m_back;   // from the oldest to the newest
+        incremental_hull m_back_hull;
+        std::vector<timed_point> m_front;  // from the newest to the oldest, so that the oldest is on top
+        upper_chain m_front_upper;         // x -> y, upper chain of the front stack
+        upper_chain m_front_lower;         // x -> -y, mirrored lower chain of the front stack
+        std::vector<chain_change> m_front_changes; // two per point of the front stack: upper, then lower
+        upper_chain_log m_removed;         // vertices removed by the insertions of both chains, in the order they were removed
+    };
+}
@@ -0,0 +1,113 @@
+#include <Trace.h>
+
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+
+namespace ch
+{
+    namespace
+    {
+        /*
+            Buffers of all the threads that ever recorded a span. A buffer outlives its thread, so that the spans of pool
+            threads can still be exported. The registry is never destroyed, since the pool threads may exit after the
+            static objects are gone.
+        */
+        class trace_registry
+        {
+        public:
+            static trace_registry& instance()
+            {
+                static trace_registry* registry{ new trace_registry{} };
+                return *registry;
+            }
+        public:
+            trace_thread_buffer* acquire()
+            {
+                std::lock_guard<std::mutex> lock{ m_mutex };
+                m_buffers.emplace_back(new trace_thread_buffer{ static_cast<int>(m_buffers.size()), {} });
+                return m_buffers.back();
+            }
+            void clear()
+            {
+                std::lock_guard<std::mutex> lock{ m_mutex };
+                for (trace_thread_buffer* buffer : m_buffers)
+                {
+                    buffer->events.clear();
+                }
+                m_start_ns = trace_now_ns();
+            }
+            bool write(const std::string& path, std::string* error)
+            {
+                std::lock_guard<std::mutex> lock{ m_mutex };
+                std::ofstream out{ path };
+                if (!out)
+                {
+                    if (error)
+                    {
+                        *error = "can't open " + path;
+                    }
+                    return false;
+                }
+
+                // complete ("X") events, with timestamps and durations in microseconds since start_tracing
+                out << std::fixed << std::setprecision(3);
+                out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+                bool first{ true };
+                for (const trace_thread_buffer* buffer : m_buffers)
+                {
+                    if (buffer->events.empty())
+                    {
+                        continue;
+                    }
+                    out << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << buffer->thread_id
+                        << ",\"args\":{\"name\":\"thread " << buffer->thread_id << "\"}}";
+                    first = false;
+                    for (const trace_event& event : buffer->events)
+                    {
+                        out << ",\n{\"name\":\"" << event.name << "\",\"cat\":\"ch\",\"ph\":\"X\",\"pid\":0,\"tid\":" << buffer->thread_id
+                            << ",\"ts\":" << static_cast<double>(event.begin_ns - m_start_ns) / 1000.0
+                            << ",\"dur\":" << static_cast<double>(event.end_ns - event.begin_ns) / 1000.0 << "}";
+                    }
+                }
+                out << "\n]}\n";
+
+                if (!out)
+                {
+                    if (error)
+                    {
+                        *error = "can't write " + path;
+                    }
+                    return false;
+                }
+                return true;
+            }
+        private:
+            std::mutex m_mutex;
+            std::vector<trace_thread_buffer*> m_buffers; // never freed, as threads keep pointers to them
+            std::int64_t m_start_ns{};
+        };
+    }
+
+    void start_tracing()
+    {
+        trace_registry::instance().clear();
+        g_tracing.store(true, std::memory_order_relaxed);
+    }
+
+    void stop_tracing()
+    {
+        g_tracing.store(false, std::memory_order_relaxed);
+    }
+
+    bool write_chrome_trace(const std::string& path, std::string* error)
+    {
+        return trace_registry::instance().write(path, error);
+    }
+
+    trace_thread_buffer* register_trace_buffer()
+    {
+        t_trace_buffer = trace_registry::instance().acquire();
+        return t_trace_buffer;
+    }
+}
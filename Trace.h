@@ -0,0 +1,102 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// spans are recorded (while tracing is started) unless this is defined as 0, in which case trace_span compiles to nothing
+#ifndef CH_TRACE
+    #define CH_TRACE 1
+#endif
+
+namespace ch
+{
+    /*
+        Phase level tracing of the algorithms (extremes, filter, region split, sort, convexify, merge, ...).
+        Each thread appends its spans to a buffer of its own, with no locking. The spans of all the threads can then be
+        exported as a Chrome trace (JSON), to be opened by chrome://tracing or by Perfetto (ui.perfetto.dev).
+
+        ch::start_tracing();
+        ch::akl_toussaint(points);
+        ch::stop_tracing();
+        ch::write_chrome_trace("trace.json");
+    */
+
+    // drops the spans recorded so far and starts recording new ones
+    void start_tracing();
+    void stop_tracing();
+
+    /*
+        Writes the spans recorded so far to path, in the Chrome trace event format. Returns false (and, if given, sets
+        error) if the file can't be written. No thread may be recording spans meanwhile (e.g. call it after stop_tracing).
+    */
+    bool write_chrome_trace(const std::string& path, std::string* error = nullptr);
+
+    struct trace_event
+    {
+        const char* name{}; // a string literal: only the pointer is stored
+        std::int64_t begin_ns{};
+        std::int64_t end_ns{};
+    };
+
+    // spans of a single thread, only ever written by their own thread
+    struct trace_thread_buffer
+    {
+        int thread_id{}; // small sequential id, in registration order
+        std::vector<trace_event> events{};
+    };
+
+    inline std::atomic<bool> g_tracing{};
+
+    // buffer of the calling thread, registered on its first span
+    inline thread_local trace_thread_buffer* t_trace_buffer{};
+    trace_thread_buffer* register_trace_buffer();
+
+    inline std::int64_t trace_now_ns()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    /*
+        Records a span named name, from its construction to its destruction, if tracing was started when it was
+        constructed. Costs a relaxed atomic load when tracing is stopped.
+    */
+    class trace_span
+    {
+    public:
+#if CH_TRACE
+        explicit trace_span(const char* name)
+            : m_name{ name }
+            , m_begin_ns{ g_tracing.load(std::memory_order_relaxed) ? trace_now_ns() : -1 }
+        {
+        }
+        ~trace_span()
+        {
+            stop();
+        }
+
+        // ends the span before the end of its scope. later calls do nothing
+        void stop()
+        {
+            if (m_begin_ns >= 0)
+            {
+                trace_thread_buffer* buffer{ t_trace_buffer ? t_trace_buffer : register_trace_buffer() };
+                buffer->events.push_back({ m_name, m_begin_ns, trace_now_ns() });
+                m_begin_ns = -1;
+            }
+        }
+#else
+        explicit trace_span(const char*) {}
+        void stop() {}
+#endif
+        trace_span(const trace_span&) = delete;
+        trace_span& operator=(const trace_span&) = delete;
+#if CH_TRACE
+    private:
+        const char* m_name;
+        std::int64_t m_begin_ns;
+#endif
+    };
+}
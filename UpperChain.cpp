@@ -0,0 +1,90 @@
+#include <UpperChain.h>
+
+#include <Predicates.h>
+
+#include <iterator>
+
+namespace ch
+{
+    v2 to_v2(upper_chain::const_iterator it)
+    {
+        return { it->first, it->second };
+    }
+
+    bool chain_contains(const upper_chain& upper, v2 p)
+    {
+        if (upper.empty() || p.x < upper.begin()->first || p.x > upper.rbegin()->first)
+        {
+            return false;
+        }
+
+        auto it{ upper.lower_bound(p.x) };
+        if (it->first == p.x)
+        {
+            return p.y <= it->second;
+        }
+        // p is strictly between the two vertices of the edge prev(it) -> it: it must not lie to its left
+        v2 from{ to_v2(std::prev(it)) };
+        v2 to{ to_v2(it) };
+        return orientation(from, to, p) <= 0;
+    }
+
+    // whether b is not a right turn from a to c, i.e. b can't be a vertex of the upper chain a -> b -> c
+    static bool is_concave(v2 a, v2 b, v2 c)
+    {
+        return orientation(a, b, c) >= 0;
+    }
+
+    int chain_insert(upper_chain& upper, v2 p, upper_chain_log* removed)
+    {
+        int removed_count{};
+        auto it{ upper.find(p.x) };
+        if (it != upper.end())
+        {
+            if (removed)
+            {
+                removed->emplace_back(it->first, it->second);
+            }
+            removed_count++;
+            it->second = p.y;
+        }
+        else
+        {
+            it = upper.emplace(p.x, p.y).first;
+        }
+
+        // remove vertices to the right of p, as long as they make a concave turn
+        while (std::next(it) != upper.end() && std::next(std::next(it)) != upper.end())
+        {
+            auto next{ std::next(it) };
+            if (!is_concave(p, to_v2(next), to_v2(std::next(next))))
+            {
+                break;
+            }
+            if (removed)
+            {
+                removed->emplace_back(next->first, next->second);
+            }
+            removed_count++;
+            upper.erase(next);
+        }
+
+        // remove vertices to the left of p, as long as they make a concave turn
+        while (it != upper.begin() && std::prev(it) != upper.begin())
+        {
+            auto prev{ std::prev(it) };
+            if (!is_concave(to_v2(std::prev(prev)), to_v2(prev), p))
+            {
+                break;
+            }
+            if (removed)
+            {
+                removed->emplace_back(prev->first, prev->second);
+            }
+            removed_count++;
+            upper.erase(prev);
+        }
+
+        return removed_count;
+    }
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <ConvexHull.h>
+
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace ch
+{
+    /*
+        Upper chain of a hull in a balanced search tree, x -> y of its vertices from left to right, shared by
+        incremental_hull and sliding_window_hull. A lower chain is kept as the upper chain of the points mirrored
+        across the x axis, i.e. x -> -y.
+    */
+    using upper_chain = std::map<double, double>;
+
+    // vertices removed from a chain by its insertions, in the order they were removed
+    using upper_chain_log = std::vector<std::pair<double, double>>;
+
+    v2 to_v2(upper_chain::const_iterator it);
+
+    // whether p is below (or on) the upper chain
+    bool chain_contains(const upper_chain& upper, v2 p);
+
+    /*
+        Adds p to the upper chain, removing the vertices that are no longer on it, and returns how many they are.
+        p must be above the chain. If removed is not null, the removed vertices are appended to it (a vertex with the
+        same x as p, which p replaces, included), so that the insertion can be undone: erase p.x, then put back the last
+        that many vertices of the log.
+    */
+    int chain_insert(upper_chain& upper, v2 p, upper_chain_log* removed = nullptr);
+}
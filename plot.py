@@ -2,6 +2,10 @@
 # $ .venv/bin/pip install matplotlib
 # $ python plot.py
 
+import struct
+import sys
+from array import array
+
 import matplotlib.pyplot as plt
 
 
@@ -32,6 +36,41 @@ def parse(filename):
     return points, hull
 
 
+# Binary point files (see PointIO.h): a header, then the coordinates (and optionally the hull) at 64 byte aligned offsets.
+BINARY_POINT_MAGIC = b"CHPOINTS"
+BINARY_POINT_HEADER = struct.Struct("=8sIIII4Q")
+
+
+def parse_binary(filename):
+    with open(filename, "rb") as f:
+        data = f.read()
+
+    magic, version, coordinate_type, layout, _, count, hull_count, points_offset, hull_offset = BINARY_POINT_HEADER.unpack_from(data)
+    if magic != BINARY_POINT_MAGIC or version != 1:
+        raise ValueError(f"{filename} is not a binary point file")
+
+    # coordinate type: 0 is double, 1 is float. layout: 0 is x0 y0 x1 y1 ..., 1 is x0 x1 ... y0 y1 ...
+    coordinates = array("d" if coordinate_type == 0 else "f")
+    coordinates.frombytes(data[points_offset:points_offset + 2 * count * coordinates.itemsize])
+    if layout == 0:
+        points = list(zip(coordinates[0::2], coordinates[1::2]))
+    else:
+        points = list(zip(coordinates[:count], coordinates[count:]))
+
+    # the hull is always stored as doubles, x0 y0 x1 y1 ...
+    hull_coordinates = array("d")
+    hull_coordinates.frombytes(data[hull_offset:hull_offset + 2 * hull_count * hull_coordinates.itemsize])
+    hull = list(zip(hull_coordinates[0::2], hull_coordinates[1::2]))
+
+    return points, hull
+
+
+def parse_any(filename):
+    with open(filename, "rb") as f:
+        is_binary = f.read(len(BINARY_POINT_MAGIC)) == BINARY_POINT_MAGIC
+    return parse_binary(filename) if is_binary else parse(filename)
+
+
 def plot(points, hull):
     if points:
         x, y = zip(*points)
@@ -60,5 +99,6 @@ def plot(points, hull):
 
 if __name__ == "__main__":
     # points, hull = parse("input.txt")
-    points, hull = parse("test.txt")
+    # either format works, e.g. $ python plot.py test.bin
+    points, hull = parse_any(sys.argv[1] if len(sys.argv) > 1 else "test.txt")
     plot(points, hull)
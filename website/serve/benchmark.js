@@ -1,659 +1,75 @@
-"use strict";
-
 const ctx = document.getElementById('canvas').getContext('2d');
 
-const naive_data = [
-    { x: 100, y: (1708 / 1000) },
-    { x: 200, y: (10532 / 1000) },
-    { x: 300, y: (34834 / 1000) },
-    { x: 400, y: (83088 / 1000) },
-    { x: 500, y: (164095 / 1000) },
-    { x: 600, y: (292061 / 1000) },
-    { x: 700, y: (477070 / 1000) },
-    { x: 800, y: (732202 / 1000) },
-    { x: 900, y: (1067762 / 1000) },
-    { x: 1000, y: (1498251 / 1000) },
-    { x: 1100, y: (2040108 / 1000) },
-    { x: 1200, y: (2697132 / 1000) },
-    { x: 1300, y: (3467098 / 1000) },
-    { x: 1400, y: (4409034 / 1000) },
-    { x: 1500, y: (5500896 / 1000) },
-    { x: 1600, y: (6751041 / 1000) },
-    { x: 1700, y: (8215693 / 1000) },
-    { x: 1800, y: (9828140 / 1000) },
-    { x: 1900, y: (11684532 / 1000) },
-    { x: 2000, y: (13751178 / 1000) },
-    { x: 2100, y: (16075027 / 1000) },
-    { x: 2200, y: (18650361 / 1000) },
-    { x: 2300, y: (21496548 / 1000) },
-    { x: 2400, y: (24552033 / 1000) },
-    { x: 2500, y: (27918752 / 1000) },
-    { x: 2600, y: (31573010 / 1000) },
-];
-
-const divide_and_conquer_data = [
-    { x: 100, y: (71 / 1000) },
-    { x: 200, y: (109 / 1000) },
-    { x: 300, y: (143 / 1000) },
-    { x: 400, y: (190 / 1000) },
-    { x: 500, y: (233 / 1000) },
-    { x: 600, y: (228 / 1000) },
-    { x: 700, y: (262 / 1000) },
-    { x: 800, y: (298 / 1000) },
-    { x: 900, y: (336 / 1000) },
-    { x: 1000, y: (358 / 1000) },
-    { x: 1100, y: (398 / 1000) },
-    { x: 1200, y: (427 / 1000) },
-    { x: 1300, y: (465 / 1000) },
-    { x: 1400, y: (528 / 1000) },
-    { x: 1500, y: (561 / 1000) },
-    { x: 1600, y: (595 / 1000) },
-    { x: 1700, y: (632 / 1000) },
-    { x: 1800, y: (653 / 1000) },
-    { x: 1900, y: (711 / 1000) },
-    { x: 2000, y: (717 / 1000) },
-    { x: 2100, y: (763 / 1000) },
-    { x: 2200, y: (803 / 1000) },
-    { x: 2300, y: (838 / 1000) },
-    { x: 2400, y: (884 / 1000) },
-    { x: 2500, y: (905 / 1000) },
-    { x: 2600, y: (961 / 1000) },
-    { x: 2700, y: (1005 / 1000) },
-    { x: 2800, y: (1068 / 1000) },
-    { x: 2900, y: (1093 / 1000) },
-    { x: 3000, y: (1140 / 1000) },
-    { x: 3100, y: (1182 / 1000) },
-    { x: 3200, y: (1207 / 1000) },
-    { x: 3300, y: (1246 / 1000) },
-    { x: 3400, y: (1278 / 1000) },
-    { x: 3500, y: (1383 / 1000) },
-    { x: 3600, y: (1503 / 1000) },
-    { x: 3700, y: (1373 / 1000) },
-    { x: 3800, y: (1430 / 1000) },
-    { x: 3900, y: (1445 / 1000) },
-    { x: 4000, y: (1471 / 1000) },
-    { x: 4100, y: (1493 / 1000) },
-    { x: 4200, y: (1522 / 1000) },
-    { x: 4300, y: (1563 / 1000) },
-    { x: 4400, y: (1603 / 1000) },
-    { x: 4500, y: (1625 / 1000) },
-    { x: 4600, y: (1663 / 1000) },
-    { x: 4700, y: (1687 / 1000) },
-    { x: 4800, y: (1736 / 1000) },
-    { x: 4900, y: (1818 / 1000) },
-    { x: 5000, y: (2028 / 1000) },
-    { x: 5100, y: (1880 / 1000) },
-    { x: 5200, y: (1879 / 1000) },
-    { x: 5300, y: (1954 / 1000) },
-    { x: 5400, y: (2039 / 1000) },
-    { x: 5500, y: (2048 / 1000) },
-    { x: 5600, y: (2068 / 1000) },
-    { x: 5700, y: (2356 / 1000) },
-    { x: 5800, y: (2277 / 1000) },
-    { x: 5900, y: (2228 / 1000) },
-    { x: 6000, y: (2338 / 1000) },
-    { x: 6100, y: (2325 / 1000) },
-    { x: 6200, y: (2410 / 1000) },
-    { x: 6300, y: (2415 / 1000) },
-    { x: 6400, y: (2686 / 1000) },
-    { x: 6500, y: (2896 / 1000) },
-    { x: 6600, y: (2830 / 1000) },
-    { x: 6700, y: (2644 / 1000) },
-    { x: 6800, y: (2567 / 1000) },
-    { x: 6900, y: (2644 / 1000) },
-    { x: 7000, y: (2871 / 1000) },
-    { x: 7100, y: (2897 / 1000) },
-    { x: 7200, y: (2678 / 1000) },
-    { x: 7300, y: (2724 / 1000) },
-    { x: 7400, y: (2736 / 1000) },
-    { x: 7500, y: (2825 / 1000) },
-    { x: 7600, y: (3083 / 1000) },
-    { x: 7700, y: (3034 / 1000) },
-    { x: 7800, y: (2875 / 1000) },
-    { x: 7900, y: (2901 / 1000) },
-    { x: 8000, y: (2941 / 1000) },
-    { x: 8100, y: (2996 / 1000) },
-    { x: 8200, y: (3222 / 1000) },
-    { x: 8300, y: (3041 / 1000) },
-    { x: 8400, y: (3343 / 1000) },
-    { x: 8500, y: (3092 / 1000) },
-    { x: 8600, y: (3162 / 1000) },
-    { x: 8700, y: (3356 / 1000) },
-    { x: 8800, y: (3437 / 1000) },
-    { x: 8900, y: (3268 / 1000) },
-    { x: 9000, y: (3296 / 1000) },
-    { x: 9100, y: (3357 / 1000) },
-    { x: 9200, y: (3454 / 1000) },
-    { x: 9300, y: (3454 / 1000) },
-    { x: 9400, y: (3505 / 1000) },
-    { x: 9500, y: (3490 / 1000) },
-    { x: 9600, y: (3875 / 1000) },
-    { x: 9700, y: (3822 / 1000) },
-    { x: 9800, y: (3584 / 1000) },
-    { x: 9900, y: (3671 / 1000) },
-];
-
-const akl_toussaint_data = [
-    { x: 100, y: (6 / 1000) },
-    { x: 200, y: (19 / 1000) },
-    { x: 300, y: (22 / 1000) },
-    { x: 400, y: (24 / 1000) },
-    { x: 500, y: (30 / 1000) },
-    { x: 600, y: (28 / 1000) },
-    { x: 700, y: (33 / 1000) },
-    { x: 800, y: (37 / 1000) },
-    { x: 900, y: (45 / 1000) },
-    { x: 1000, y: (93 / 1000) },
-    { x: 1100, y: (73 / 1000) },
-    { x: 1200, y: (73 / 1000) },
-    { x: 1300, y: (92 / 1000) },
-    { x: 1400, y: (137 / 1000) },
-    { x: 1500, y: (131 / 1000) },
-    { x: 1600, y: (151 / 1000) },
-    { x: 1700, y: (146 / 1000) },
-    { x: 1800, y: (128 / 1000) },
-    { x: 1900, y: (137 / 1000) },
-    { x: 2000, y: (168 / 1000) },
-    { x: 2100, y: (180 / 1000) },
-    { x: 2200, y: (186 / 1000) },
-    { x: 2300, y: (193 / 1000) },
-    { x: 2400, y: (199 / 1000) },
-    { x: 2500, y: (213 / 1000) },
-    { x: 2600, y: (225 / 1000) },
-    { x: 2700, y: (233 / 1000) },
-    { x: 2800, y: (298 / 1000) },
-    { x: 2900, y: (301 / 1000) },
-    { x: 3000, y: (310 / 1000) },
-    { x: 3100, y: (338 / 1000) },
-    { x: 3200, y: (353 / 1000) },
-    { x: 3300, y: (366 / 1000) },
-    { x: 3400, y: (291 / 1000) },
-    { x: 3500, y: (292 / 1000) },
-    { x: 3600, y: (297 / 1000) },
-    { x: 3700, y: (307 / 1000) },
-    { x: 3800, y: (321 / 1000) },
-    { x: 3900, y: (335 / 1000) },
-    { x: 4000, y: (344 / 1000) },
-    { x: 4100, y: (355 / 1000) },
-    { x: 4200, y: (367 / 1000) },
-    { x: 4300, y: (375 / 1000) },
-    { x: 4400, y: (384 / 1000) },
-    { x: 4500, y: (396 / 1000) },
-    { x: 4600, y: (410 / 1000) },
-    { x: 4700, y: (419 / 1000) },
-    { x: 4800, y: (418 / 1000) },
-    { x: 4900, y: (430 / 1000) },
-    { x: 5000, y: (438 / 1000) },
-    { x: 5100, y: (448 / 1000) },
-    { x: 5200, y: (474 / 1000) },
-    { x: 5300, y: (487 / 1000) },
-    { x: 5400, y: (497 / 1000) },
-    { x: 5500, y: (513 / 1000) },
-    { x: 5600, y: (525 / 1000) },
-    { x: 5700, y: (537 / 1000) },
-    { x: 5800, y: (566 / 1000) },
-    { x: 5900, y: (611 / 1000) },
-    { x: 6000, y: (629 / 1000) },
-    { x: 6100, y: (632 / 1000) },
-    { x: 6200, y: (644 / 1000) },
-    { x: 6300, y: (724 / 1000) },
-    { x: 6400, y: (665 / 1000) },
-    { x: 6500, y: (660 / 1000) },
-    { x: 6600, y: (677 / 1000) },
-    { x: 6700, y: (677 / 1000) },
-    { x: 6800, y: (687 / 1000) },
-    { x: 6900, y: (703 / 1000) },
-    { x: 7000, y: (1098 / 1000) },
-    { x: 7100, y: (953 / 1000) },
-    { x: 7200, y: (1094 / 1000) },
-    { x: 7300, y: (1007 / 1000) },
-    { x: 7400, y: (1009 / 1000) },
-    { x: 7500, y: (1025 / 1000) },
-    { x: 7600, y: (1071 / 1000) },
-    { x: 7700, y: (1060 / 1000) },
-    { x: 7800, y: (1410 / 1000) },
-    { x: 7900, y: (1229 / 1000) },
-    { x: 8000, y: (1238 / 1000) },
-    { x: 8100, y: (1417 / 1000) },
-    { x: 8200, y: (1437 / 1000) },
-    { x: 8300, y: (1479 / 1000) },
-    { x: 8400, y: (1498 / 1000) },
-    { x: 8500, y: (1516 / 1000) },
-    { x: 8600, y: (1548 / 1000) },
-    { x: 8700, y: (1585 / 1000) },
-    { x: 8800, y: (1709 / 1000) },
-    { x: 8900, y: (1876 / 1000) },
-    { x: 9000, y: (1887 / 1000) },
-    { x: 9100, y: (1723 / 1000) },
-    { x: 9200, y: (1745 / 1000) },
-    { x: 9300, y: (1779 / 1000) },
-    { x: 9400, y: (1826 / 1000) },
-    { x: 9500, y: (1877 / 1000) },
-    { x: 9600, y: (1886 / 1000) },
-    { x: 9700, y: (1922 / 1000) },
-    { x: 9800, y: (1908 / 1000) },
-    { x: 9900, y: (2097 / 1000) },
-];
+// benchmark.json is written by "ConvexHull benchmark" (see Benchmark.h): one result per (algorithm, distribution, n)
+const benchmark_path = 'benchmark.json';
 
-const torch_data = [
-    { x: 100, y: (14 / 1000) },
-    { x: 200, y: (16 / 1000) },
-    { x: 300, y: (19 / 1000) },
-    { x: 400, y: (20 / 1000) },
-    { x: 500, y: (24 / 1000) },
-    { x: 600, y: (31 / 1000) },
-    { x: 700, y: (33 / 1000) },
-    { x: 800, y: (33 / 1000) },
-    { x: 900, y: (42 / 1000) },
-    { x: 1000, y: (44 / 1000) },
-    { x: 1100, y: (72 / 1000) },
-    { x: 1200, y: (59 / 1000) },
-    { x: 1300, y: (58 / 1000) },
-    { x: 1400, y: (62 / 1000) },
-    { x: 1500, y: (68 / 1000) },
-    { x: 1600, y: (92 / 1000) },
-    { x: 1700, y: (103 / 1000) },
-    { x: 1800, y: (100 / 1000) },
-    { x: 1900, y: (105 / 1000) },
-    { x: 2000, y: (110 / 1000) },
-    { x: 2100, y: (114 / 1000) },
-    { x: 2200, y: (120 / 1000) },
-    { x: 2300, y: (124 / 1000) },
-    { x: 2400, y: (134 / 1000) },
-    { x: 2500, y: (138 / 1000) },
-    { x: 2600, y: (144 / 1000) },
-    { x: 2700, y: (144 / 1000) },
-    { x: 2800, y: (150 / 1000) },
-    { x: 2900, y: (156 / 1000) },
-    { x: 3000, y: (166 / 1000) },
-    { x: 3100, y: (168 / 1000) },
-    { x: 3200, y: (173 / 1000) },
-    { x: 3300, y: (179 / 1000) },
-    { x: 3400, y: (187 / 1000) },
-    { x: 3500, y: (198 / 1000) },
-    { x: 3600, y: (202 / 1000) },
-    { x: 3700, y: (207 / 1000) },
-    { x: 3800, y: (214 / 1000) },
-    { x: 3900, y: (222 / 1000) },
-    { x: 4000, y: (228 / 1000) },
-    { x: 4100, y: (233 / 1000) },
-    { x: 4200, y: (241 / 1000) },
-    { x: 4300, y: (316 / 1000) },
-    { x: 4400, y: (258 / 1000) },
-    { x: 4500, y: (265 / 1000) },
-    { x: 4600, y: (269 / 1000) },
-    { x: 4700, y: (272 / 1000) },
-    { x: 4800, y: (279 / 1000) },
-    { x: 4900, y: (289 / 1000) },
-    { x: 5000, y: (292 / 1000) },
-    { x: 5100, y: (296 / 1000) },
-    { x: 5200, y: (306 / 1000) },
-    { x: 5300, y: (314 / 1000) },
-    { x: 5400, y: (330 / 1000) },
-    { x: 5500, y: (319 / 1000) },
-    { x: 5600, y: (323 / 1000) },
-    { x: 5700, y: (329 / 1000) },
-    { x: 5800, y: (335 / 1000) },
-    { x: 5900, y: (342 / 1000) },
-    { x: 6000, y: (352 / 1000) },
-    { x: 6100, y: (360 / 1000) },
-    { x: 6200, y: (365 / 1000) },
-    { x: 6300, y: (369 / 1000) },
-    { x: 6400, y: (375 / 1000) },
-    { x: 6500, y: (490 / 1000) },
-    { x: 6600, y: (391 / 1000) },
-    { x: 6700, y: (400 / 1000) },
-    { x: 6800, y: (403 / 1000) },
-    { x: 6900, y: (407 / 1000) },
-    { x: 7000, y: (421 / 1000) },
-    { x: 7100, y: (431 / 1000) },
-    { x: 7200, y: (427 / 1000) },
-    { x: 7300, y: (433 / 1000) },
-    { x: 7400, y: (440 / 1000) },
-    { x: 7500, y: (453 / 1000) },
-    { x: 7600, y: (459 / 1000) },
-    { x: 7700, y: (456 / 1000) },
-    { x: 7800, y: (455 / 1000) },
-    { x: 7900, y: (473 / 1000) },
-    { x: 8000, y: (547 / 1000) },
-    { x: 8100, y: (499 / 1000) },
-    { x: 8200, y: (501 / 1000) },
-    { x: 8300, y: (602 / 1000) },
-    { x: 8400, y: (638 / 1000) },
-    { x: 8500, y: (520 / 1000) },
-    { x: 8600, y: (600 / 1000) },
-    { x: 8700, y: (519 / 1000) },
-    { x: 8800, y: (522 / 1000) },
-    { x: 8900, y: (515 / 1000) },
-    { x: 9000, y: (523 / 1000) },
-    { x: 9100, y: (525 / 1000) },
-    { x: 9200, y: (526 / 1000) },
-    { x: 9300, y: (536 / 1000) },
-    { x: 9400, y: (538 / 1000) },
-    { x: 9500, y: (691 / 1000) },
-    { x: 9600, y: (572 / 1000) },
-    { x: 9700, y: (571 / 1000) },
-    { x: 9800, y: (575 / 1000) },
-    { x: 9900, y: (580 / 1000) },
-];
+const algorithm_styles = {
+    naive: { label: 'Naive', color: 'red' },
+    naive_akl_toussaint: { label: 'Naive + Akl Toussaint', color: 'orange' },
+    divide_and_conquer: { label: 'Divide and Conquer', color: 'green' },
+    divide_and_conquer_akl_toussaint: { label: 'Divide and Conquer + Akl Toussaint', color: 'lightgreen' },
+    divide_and_conquer_parallel: { label: 'Divide and Conquer (parallel)', color: 'darkgreen' },
+    akl_toussaint: { label: 'Akl Toussaint', color: 'blue' },
+    torch: { label: 'Torch', color: 'pink' },
+    torch_akl_toussaint: { label: 'Torch + Akl Toussaint', color: 'violet' },
+    monotone_chain: { label: 'Monotone Chain', color: 'teal' },
+    quickhull: { label: 'Quickhull', color: 'brown' },
+    chan: { label: 'Chan', color: 'gold' },
+    kirkpatrick_seidel: { label: 'Kirkpatrick Seidel', color: 'gray' },
+    kirkpatrick_seidel_akl_toussaint: { label: 'Kirkpatrick Seidel + Akl Toussaint', color: 'black' },
+};
 
-const naive_akl_toussaint_data = [
-    { x: 100, y: (58 / 1000) },
-    { x: 200, y: (1536 / 1000) },
-    { x: 300, y: (5192 / 1000) },
-    { x: 400, y: (12587 / 1000) },
-    { x: 500, y: (25625 / 1000) },
-    { x: 600, y: (14671 / 1000) },
-    { x: 700, y: (14926 / 1000) },
-    { x: 800, y: (24475 / 1000) },
-    { x: 900, y: (32201 / 1000) },
-    { x: 1000, y: (46671 / 1000) },
-    { x: 1100, y: (67463 / 1000) },
-    { x: 1200, y: (85246 / 1000) },
-    { x: 1300, y: (205460 / 1000) },
-    { x: 1400, y: (252061 / 1000) },
-    { x: 1500, y: (308718 / 1000) },
-    { x: 1600, y: (374089 / 1000) },
-    { x: 1700, y: (452690 / 1000) },
-    { x: 1800, y: (555734 / 1000) },
-    { x: 1900, y: (653796 / 1000) },
-    { x: 2000, y: (1521539 / 1000) },
-    { x: 2100, y: (1780263 / 1000) },
-    { x: 2200, y: (2082286 / 1000) },
-    { x: 2300, y: (2363269 / 1000) },
-    { x: 2400, y: (2625356 / 1000) },
-    { x: 2500, y: (3028946 / 1000) },
-    { x: 2600, y: (3468506 / 1000) },
-    { x: 2700, y: (3903217 / 1000) },
-    { x: 2800, y: (7393561 / 1000) },
-    { x: 2900, y: (8118193 / 1000) },
-    { x: 3000, y: (8903079 / 1000) },
-    { x: 3100, y: (10275310 / 1000) },
-    { x: 3200, y: (11357685 / 1000) },
-    { x: 3300, y: (12382908 / 1000) },
-    { x: 3400, y: (6399078 / 1000) },
-    { x: 3500, y: (6996924 / 1000) },
-    { x: 3600, y: (7467407 / 1000) },
-    { x: 3700, y: (8098350 / 1000) },
-    { x: 3800, y: (8784664 / 1000) },
-    { x: 3900, y: (9508646 / 1000) },
-    { x: 4000, y: (10368262 / 1000) },
-    { x: 4100, y: (11327810 / 1000) },
-    { x: 4200, y: (12253622 / 1000) },
-    { x: 4300, y: (13169870 / 1000) },
-    { x: 4400, y: (14023253 / 1000) },
-    { x: 4500, y: (15001231 / 1000) },
-];
-
-const divide_and_conquer_akl_toussaint_data = [
-    { x: 100, y: (28 / 1000) },
-    { x: 200, y: (65 / 1000) },
-    { x: 300, y: (85 / 1000) },
-    { x: 400, y: (112 / 1000) },
-    { x: 500, y: (114 / 1000) },
-    { x: 600, y: (136 / 1000) },
-    { x: 700, y: (107 / 1000) },
-    { x: 800, y: (146 / 1000) },
-    { x: 900, y: (147 / 1000) },
-    { x: 1000, y: (132 / 1000) },
-    { x: 1100, y: (165 / 1000) },
-    { x: 1200, y: (184 / 1000) },
-    { x: 1300, y: (233 / 1000) },
-    { x: 1400, y: (247 / 1000) },
-    { x: 1500, y: (262 / 1000) },
-    { x: 1600, y: (273 / 1000) },
-    { x: 1700, y: (297 / 1000) },
-    { x: 1800, y: (316 / 1000) },
-    { x: 1900, y: (333 / 1000) },
-    { x: 2000, y: (416 / 1000) },
-    { x: 2100, y: (413 / 1000) },
-    { x: 2200, y: (445 / 1000) },
-    { x: 2300, y: (463 / 1000) },
-    { x: 2400, y: (487 / 1000) },
-    { x: 2500, y: (663 / 1000) },
-    { x: 2600, y: (541 / 1000) },
-    { x: 2700, y: (596 / 1000) },
-    { x: 2800, y: (719 / 1000) },
-    { x: 2900, y: (720 / 1000) },
-    { x: 3000, y: (720 / 1000) },
-    { x: 3100, y: (761 / 1000) },
-    { x: 3200, y: (781 / 1000) },
-    { x: 3300, y: (798 / 1000) },
-    { x: 3400, y: (704 / 1000) },
-    { x: 3500, y: (698 / 1000) },
-    { x: 3600, y: (709 / 1000) },
-    { x: 3700, y: (726 / 1000) },
-    { x: 3800, y: (743 / 1000) },
-    { x: 3900, y: (769 / 1000) },
-    { x: 4000, y: (781 / 1000) },
-    { x: 4100, y: (816 / 1000) },
-    { x: 4200, y: (825 / 1000) },
-    { x: 4300, y: (833 / 1000) },
-    { x: 4400, y: (850 / 1000) },
-    { x: 4500, y: (879 / 1000) },
-    { x: 4600, y: (971 / 1000) },
-    { x: 4700, y: (915 / 1000) },
-    { x: 4800, y: (927 / 1000) },
-    { x: 4900, y: (927 / 1000) },
-    { x: 5000, y: (944 / 1000) },
-    { x: 5100, y: (989 / 1000) },
-    { x: 5200, y: (1006 / 1000) },
-    { x: 5300, y: (1032 / 1000) },
-    { x: 5400, y: (1056 / 1000) },
-    { x: 5500, y: (1066 / 1000) },
-    { x: 5600, y: (1096 / 1000) },
-    { x: 5700, y: (1117 / 1000) },
-    { x: 5800, y: (1188 / 1000) },
-    { x: 5900, y: (1173 / 1000) },
-    { x: 6000, y: (1199 / 1000) },
-    { x: 6100, y: (1247 / 1000) },
-    { x: 6200, y: (1400 / 1000) },
-    { x: 6300, y: (1380 / 1000) },
-    { x: 6400, y: (1414 / 1000) },
-    { x: 6500, y: (1341 / 1000) },
-    { x: 6600, y: (1361 / 1000) },
-    { x: 6700, y: (1397 / 1000) },
-    { x: 6800, y: (1415 / 1000) },
-    { x: 6900, y: (1421 / 1000) },
-    { x: 7000, y: (1498 / 1000) },
-    { x: 7100, y: (1548 / 1000) },
-    { x: 7200, y: (1599 / 1000) },
-    { x: 7300, y: (1788 / 1000) },
-    { x: 7400, y: (1792 / 1000) },
-    { x: 7500, y: (1586 / 1000) },
-    { x: 7600, y: (1580 / 1000) },
-    { x: 7700, y: (1662 / 1000) },
-    { x: 7800, y: (1702 / 1000) },
-    { x: 7900, y: (1764 / 1000) },
-    { x: 8000, y: (1743 / 1000) },
-    { x: 8100, y: (1901 / 1000) },
-    { x: 8200, y: (1902 / 1000) },
-    { x: 8300, y: (1948 / 1000) },
-    { x: 8400, y: (2057 / 1000) },
-    { x: 8500, y: (1975 / 1000) },
-    { x: 8600, y: (2000 / 1000) },
-    { x: 8700, y: (2013 / 1000) },
-    { x: 8800, y: (2025 / 1000) },
-    { x: 8900, y: (2060 / 1000) },
-    { x: 9000, y: (2085 / 1000) },
-    { x: 9100, y: (2102 / 1000) },
-    { x: 9200, y: (2145 / 1000) },
-    { x: 9300, y: (2183 / 1000) },
-    { x: 9400, y: (2228 / 1000) },
-    { x: 9500, y: (2244 / 1000) },
-    { x: 9600, y: (2322 / 1000) },
-    { x: 9700, y: (2448 / 1000) },
-    { x: 9800, y: (2565 / 1000) },
-    { x: 9900, y: (2356 / 1000) },
-];
-
-const torch_akl_toussaint_data = [
-    { x: 100, y: (11 / 1000) },
-    { x: 200, y: (16 / 1000) },
-    { x: 300, y: (18 / 1000) },
-    { x: 400, y: (20 / 1000) },
-    { x: 500, y: (26 / 1000) },
-    { x: 600, y: (22 / 1000) },
-    { x: 700, y: (31 / 1000) },
-    { x: 800, y: (47 / 1000) },
-    { x: 900, y: (43 / 1000) },
-    { x: 1000, y: (38 / 1000) },
-    { x: 1100, y: (43 / 1000) },
-    { x: 1200, y: (42 / 1000) },
-    { x: 1300, y: (49 / 1000) },
-    { x: 1400, y: (46 / 1000) },
-    { x: 1500, y: (80 / 1000) },
-    { x: 1600, y: (58 / 1000) },
-    { x: 1700, y: (60 / 1000) },
-    { x: 1800, y: (84 / 1000) },
-    { x: 1900, y: (64 / 1000) },
-    { x: 2000, y: (90 / 1000) },
-    { x: 2100, y: (96 / 1000) },
-    { x: 2200, y: (110 / 1000) },
-    { x: 2300, y: (126 / 1000) },
-    { x: 2400, y: (139 / 1000) },
-    { x: 2500, y: (124 / 1000) },
-    { x: 2600, y: (146 / 1000) },
-    { x: 2700, y: (185 / 1000) },
-    { x: 2800, y: (140 / 1000) },
-    { x: 2900, y: (152 / 1000) },
-    { x: 3000, y: (154 / 1000) },
-    { x: 3100, y: (164 / 1000) },
-    { x: 3200, y: (181 / 1000) },
-    { x: 3300, y: (184 / 1000) },
-    { x: 3400, y: (186 / 1000) },
-    { x: 3500, y: (187 / 1000) },
-    { x: 3600, y: (190 / 1000) },
-    { x: 3700, y: (194 / 1000) },
-    { x: 3800, y: (204 / 1000) },
-    { x: 3900, y: (209 / 1000) },
-    { x: 4000, y: (209 / 1000) },
-    { x: 4100, y: (214 / 1000) },
-    { x: 4200, y: (219 / 1000) },
-    { x: 4300, y: (221 / 1000) },
-    { x: 4400, y: (236 / 1000) },
-    { x: 4500, y: (245 / 1000) },
-    { x: 4600, y: (328 / 1000) },
-    { x: 4700, y: (256 / 1000) },
-    { x: 4800, y: (278 / 1000) },
-    { x: 4900, y: (261 / 1000) },
-    { x: 5000, y: (276 / 1000) },
-    { x: 5100, y: (277 / 1000) },
-    { x: 5200, y: (284 / 1000) },
-    { x: 5300, y: (285 / 1000) },
-    { x: 5400, y: (293 / 1000) },
-    { x: 5500, y: (312 / 1000) },
-    { x: 5600, y: (319 / 1000) },
-    { x: 5700, y: (325 / 1000) },
-    { x: 5800, y: (329 / 1000) },
-    { x: 5900, y: (362 / 1000) },
-    { x: 6000, y: (365 / 1000) },
-    { x: 6100, y: (369 / 1000) },
-    { x: 6200, y: (365 / 1000) },
-    { x: 6300, y: (365 / 1000) },
-    { x: 6400, y: (371 / 1000) },
-    { x: 6500, y: (379 / 1000) },
-    { x: 6600, y: (389 / 1000) },
-    { x: 6700, y: (388 / 1000) },
-    { x: 6800, y: (393 / 1000) },
-    { x: 6900, y: (392 / 1000) },
-    { x: 7000, y: (397 / 1000) },
-    { x: 7100, y: (401 / 1000) },
-    { x: 7200, y: (396 / 1000) },
-    { x: 7300, y: (407 / 1000) },
-    { x: 7400, y: (416 / 1000) },
-    { x: 7500, y: (469 / 1000) },
-    { x: 7600, y: (419 / 1000) },
-    { x: 7700, y: (494 / 1000) },
-    { x: 7800, y: (490 / 1000) },
-    { x: 7900, y: (449 / 1000) },
-    { x: 8000, y: (464 / 1000) },
-    { x: 8100, y: (487 / 1000) },
-    { x: 8200, y: (440 / 1000) },
-    { x: 8300, y: (453 / 1000) },
-    { x: 8400, y: (472 / 1000) },
-    { x: 8500, y: (575 / 1000) },
-    { x: 8600, y: (467 / 1000) },
-    { x: 8700, y: (485 / 1000) },
-    { x: 8800, y: (520 / 1000) },
-    { x: 8900, y: (521 / 1000) },
-    { x: 9000, y: (523 / 1000) },
-    { x: 9100, y: (531 / 1000) },
-    { x: 9200, y: (522 / 1000) },
-    { x: 9300, y: (530 / 1000) },
-    { x: 9400, y: (560 / 1000) },
-    { x: 9500, y: (564 / 1000) },
-    { x: 9600, y: (566 / 1000) },
-    { x: 9700, y: (576 / 1000) },
-    { x: 9800, y: (582 / 1000) },
-    { x: 9900, y: (576 / 1000) },
-];
+function make_datasets(results) {
+    const distributions = new Set(results.map(r => r.distribution));
+    const series = new Map();
+    for (const r of results) {
+        const key = distributions.size > 1 ? `${r.algorithm} ${r.distribution}` : r.algorithm;
+        if (!series.has(key)) {
+            const style = algorithm_styles[r.algorithm] ?? { label: r.algorithm, color: undefined };
+            const label = distributions.size > 1 ? `${style.label} (${r.distribution})` : style.label;
+            series.set(key, { label: label, data: [], borderColor: style.color, tension: 0.2 });
+        }
+        series.get(key).data.push({ x: r.n, y: r.median_ns / 1e6 });
+    }
+    for (const dataset of series.values()) {
+        dataset.data.sort((a, b) => a.x - b.x);
+    }
+    return [...series.values()];
+}
 
-const chart = new Chart(ctx, {
-    type: 'line',
-    data: {
-        datasets: [
-            {
-                label: 'Naive',
-                data: naive_data,
-                borderColor: 'red',
-                tension: 0.2,
-            },
-            {
-                label: 'Naive + Akl Toussaint',
-                data: naive_akl_toussaint_data,
-                borderColor: 'orange',
-                tension: 0.2,
-            },
-            {
-                label: 'Divide and Conquer',
-                data: divide_and_conquer_data,
-                borderColor: 'green',
-                tension: 0.2,
-            },
-            {
-                label: 'Divide and Conquer + Akl Toussaint',
-                data: divide_and_conquer_akl_toussaint_data,
-                borderColor: 'lightgreen',
-                tension: 0.2,
-            },
-            {
-                label: 'Akl Toussaint',
-                data: akl_toussaint_data,
-                borderColor: 'blue',
-                tension: 0.2,
-            },
-            {
-                label: 'Torch',
-                data: torch_data,
-                borderColor: 'pink',
-                tension: 0.2,
-            },
-            {
-                label: 'Torch + Akl Toussaint',
-                data: torch_akl_toussaint_data,
-                borderColor: 'violet',
-                tension: 0.2,
-            },
-        ]
-    },
-    options: {
-        responsive: true,
-        scales: {
-            x: {
-                type: 'linear',
-                position: 'bottom',
-                title: {
-                    display: true,
-                    text: 'Input Size'
-                }
-            },
-            y: {
-                title: {
-                    display: true,
-                    text: 'Time (ms)'
+function make_chart(results) {
+    const sizes = results.map(r => r.n);
+    // geometric size sweeps (e.g. 100 to 100M) are only readable on log scales
+    const logarithmic = Math.max(...sizes) / Math.min(...sizes) > 1000;
+    return new Chart(ctx, {
+        type: 'line',
+        data: {
+            datasets: make_datasets(results),
+        },
+        options: {
+            responsive: true,
+            scales: {
+                x: {
+                    type: logarithmic ? 'logarithmic' : 'linear',
+                    position: 'bottom',
+                    title: {
+                        display: true,
+                        text: 'Input Size'
+                    }
+                },
+                y: {
+                    type: logarithmic ? 'logarithmic' : 'linear',
+                    title: {
+                        display: true,
+                        text: 'Time (ms)'
+                    }
                 }
             }
         }
-    }
-});
+    });
+}
+
+fetch(benchmark_path)
+    .then(response => response.json())
+    .then(benchmark => make_chart(benchmark.results))
+    .catch(error => console.error(`can't load ${benchmark_path}: ${error}`));